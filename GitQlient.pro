@@ -2,7 +2,7 @@
 CONFIG += qt warn_on c++17 c++1z
 
 TARGET = gitqlient
-QT += widgets core network webenginewidgets webchannel
+QT += widgets core concurrent network webenginewidgets webchannel
 DEFINES += QT_DEPRECATED_WARNINGS
 
 unix {
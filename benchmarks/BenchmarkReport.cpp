@@ -0,0 +1,58 @@
+#include "BenchmarkReport.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+
+bool BenchmarkReport::append(const QString &xmlFile)
+{
+   QFile file(xmlFile);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+   QXmlStreamReader xml(&file);
+   QString testCase;
+   QString function;
+
+   while (!xml.atEnd())
+   {
+      if (xml.readNext() != QXmlStreamReader::StartElement)
+         continue;
+
+      const auto attributes = xml.attributes();
+
+      if (xml.name() == QLatin1String("TestCase"))
+         testCase = attributes.value(QLatin1String("name")).toString();
+      else if (xml.name() == QLatin1String("TestFunction"))
+         function = attributes.value(QLatin1String("name")).toString();
+      else if (xml.name() == QLatin1String("BenchmarkResult"))
+      {
+         // QTest already writes the value per iteration.
+         mResults.append(QJsonObject {
+             { "testCase", testCase },
+             { "function", function },
+             { "tag", attributes.value(QLatin1String("tag")).toString() },
+             { "metric", attributes.value(QLatin1String("metric")).toString() },
+             { "value", attributes.value(QLatin1String("value")).toDouble() },
+             { "iterations", attributes.value(QLatin1String("iterations")).toInt() },
+         });
+      }
+   }
+
+   return !xml.hasError();
+}
+
+bool BenchmarkReport::write(const QString &jsonFile) const
+{
+   QSaveFile file(jsonFile);
+
+   if (!file.open(QIODevice::WriteOnly))
+      return false;
+
+   file.write(QJsonDocument(QJsonObject { { "results", mResults } }).toJson());
+
+   return file.commit();
+}
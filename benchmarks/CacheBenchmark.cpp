@@ -0,0 +1,136 @@
+#include "CacheBenchmark.h"
+
+#include <GitCache.h>
+#include <GitLogParser.h>
+#include <LogGenerator.h>
+#include <WipRevisionInfo.h>
+
+#include <QtTest>
+
+namespace
+{
+void addSizes()
+{
+   QTest::addColumn<int>("commits");
+
+   for (const auto commits : LogGenerator::historySizes())
+      QTest::newRow(qPrintable(QString::number(commits))) << commits;
+}
+
+QVector<CommitInfo> history(int commits)
+{
+   return GitLogParser::parseUnsignedLog(LogGenerator::unsignedLog(commits));
+}
+
+WipRevisionInfo wipInfo(const QVector<CommitInfo> &commits)
+{
+   return { commits.isEmpty() ? QString() : commits.constFirst().sha, RevisionFiles(), {} };
+}
+}
+
+void CacheBenchmark::setup_data()
+{
+   addSizes();
+}
+
+void CacheBenchmark::setup()
+{
+   QFETCH(int, commits);
+
+   const auto revisions = history(commits);
+   const auto wip = wipInfo(revisions);
+
+   QBENCHMARK
+   {
+      GitCache cache;
+      cache.setup(wip, revisions);
+   }
+}
+
+void CacheBenchmark::computeLanes_data()
+{
+   addSizes();
+}
+
+void CacheBenchmark::computeLanes()
+{
+   QFETCH(int, commits);
+
+   GitCache cache;
+   const auto revisions = history(commits);
+   cache.setup(wipInfo(revisions), revisions);
+
+   // The lanes are only computed once per cache, so the whole pass is measured once. The view only computes the
+   // rows close to the computed ones, the whole pass is what the background fill does.
+   QBENCHMARK_ONCE
+   {
+      cache.computeLanesUpTo(commits);
+   }
+
+   QVERIFY(cache.lanesComplete());
+}
+
+void CacheBenchmark::computeVisibleLanes_data()
+{
+   addSizes();
+}
+
+void CacheBenchmark::computeVisibleLanes()
+{
+   QFETCH(int, commits);
+
+   GitCache cache;
+   const auto revisions = history(commits);
+   cache.setup(wipInfo(revisions), revisions);
+
+   // What the view needs to paint the first screen after the history is loaded.
+   QBENCHMARK_ONCE
+   {
+      cache.computeLanes(50);
+   }
+
+   QVERIFY(!cache.commitInfo(50).lanes().isEmpty());
+}
+
+void CacheBenchmark::searchCommitInfo_data()
+{
+   addSizes();
+}
+
+void CacheBenchmark::searchCommitInfo()
+{
+   QFETCH(int, commits);
+
+   GitCache cache;
+   const auto revisions = history(commits);
+   cache.setup(wipInfo(revisions), revisions);
+
+   // The text is only in the last commit, so the whole history is scanned.
+   const auto text = QString("Change number %1 in").arg(commits - 1);
+
+   QBENCHMARK
+   {
+      QVERIFY(!cache.searchCommitInfo(text).sha.isEmpty());
+   }
+}
+
+void CacheBenchmark::commitInfoByPrefix_data()
+{
+   addSizes();
+}
+
+void CacheBenchmark::commitInfoByPrefix()
+{
+   QFETCH(int, commits);
+
+   GitCache cache;
+   const auto revisions = history(commits);
+   cache.setup(wipInfo(revisions), revisions);
+
+   const auto prefix = revisions.constLast().sha.left(8);
+
+   QBENCHMARK
+   {
+      QVERIFY(!cache.commitInfo(prefix).sha.isEmpty());
+   }
+}
@@ -0,0 +1,151 @@
+#include "CommitParserBenchmark.h"
+
+#include <CommitInfo.h>
+#include <GitLogParser.h>
+#include <LogGenerator.h>
+
+#include <QRegExp>
+#include <QtTest>
+
+namespace
+{
+// Reference implementation of the parsing done before the byte-level parser existed. It's kept to measure the gain.
+struct LegacyCommit
+{
+   QString sha;
+   QStringList parents;
+   QString committer;
+   QString author;
+   qint64 date = 0;
+   QString shortLog;
+   QString longLog;
+};
+
+QVector<LegacyCommit> legacyParse(QByteArray log)
+{
+   static QRegExp hexMatcher("^[0-9A-F]{40}$", Qt::CaseInsensitive);
+
+   auto lines = log.split('\000');
+   QVector<LegacyCommit> commits;
+   commits.reserve(lines.count());
+
+   while (!lines.isEmpty())
+   {
+      const auto fields = QString::fromUtf8(lines.takeFirst()).split('\n');
+      LegacyCommit commit;
+      auto shas = fields.at(1).split('X');
+      commit.sha = shas.takeFirst().remove(0, 1);
+
+      if (!shas.isEmpty())
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+         commit.parents = shas.takeFirst().split(' ', Qt::SkipEmptyParts);
+#else
+         commit.parents = shas.takeFirst().split(' ', QString::SkipEmptyParts);
+#endif
+
+      commit.committer = fields.at(2);
+      commit.author = fields.at(3);
+      commit.date = fields.at(4).toInt();
+      commit.shortLog = fields.at(5);
+
+      for (auto i = 6; i < fields.count(); ++i)
+         commit.longLog += fields.at(i) + '\n';
+
+      commit.longLog = commit.longLog.trimmed();
+
+      if (hexMatcher.exactMatch(commit.sha))
+         commits.append(std::move(commit));
+   }
+
+   return commits;
+}
+
+void addSizes()
+{
+   QTest::addColumn<int>("commits");
+
+   for (const auto commits : LogGenerator::historySizes())
+      QTest::newRow(qPrintable(QString::number(commits))) << commits;
+}
+}
+
+void CommitParserBenchmark::legacyParse_data()
+{
+   addSizes();
+}
+
+void CommitParserBenchmark::legacyParse()
+{
+   QFETCH(int, commits);
+
+   const auto log = LogGenerator::unsignedLog(commits);
+
+   QBENCHMARK
+   {
+      const auto parsed = ::legacyParse(log);
+      QVERIFY(!parsed.isEmpty());
+   }
+}
+
+void CommitParserBenchmark::parseUnsignedLog_data()
+{
+   addSizes();
+}
+
+void CommitParserBenchmark::parseUnsignedLog()
+{
+   QFETCH(int, commits);
+
+   const auto log = LogGenerator::unsignedLog(commits);
+
+   QBENCHMARK
+   {
+      const auto parsed = GitLogParser::parseUnsignedLog(log);
+      QVERIFY(!parsed.isEmpty());
+   }
+}
+
+void CommitParserBenchmark::parseSignedLog_data()
+{
+   addSizes();
+}
+
+void CommitParserBenchmark::parseSignedLog()
+{
+   QFETCH(int, commits);
+
+   const auto log = LogGenerator::signedLog(commits);
+
+   QBENCHMARK
+   {
+      // The parser works in place.
+      auto copy = log;
+      const auto parsed = GitLogParser::parseSignedLog(copy);
+      QVERIFY(!parsed.isEmpty());
+   }
+}
+
+void CommitParserBenchmark::sameResult()
+{
+   const auto log = LogGenerator::unsignedLog(1000);
+   const auto legacy = ::legacyParse(log);
+   const auto commits = GitLogParser::parseUnsignedLog(log);
+
+   QCOMPARE(commits.count(), legacy.count());
+
+   for (auto i = 0; i < commits.count(); ++i)
+   {
+      QCOMPARE(commits.at(i).sha, legacy.at(i).sha);
+      QCOMPARE(commits.at(i).parents(), legacy.at(i).parents);
+      QCOMPARE(commits.at(i).committer.toString(), legacy.at(i).committer);
+      QCOMPARE(commits.at(i).author.toString(), legacy.at(i).author);
+      QCOMPARE(static_cast<qint64>(commits.at(i).dateSinceEpoch.count()), legacy.at(i).date);
+      QCOMPARE(commits.at(i).shortLog, legacy.at(i).shortLog);
+      QCOMPARE(commits.at(i).longLog, legacy.at(i).longLog);
+   }
+
+   auto signedLog = LogGenerator::signedLog(1000);
+   const auto signedCommits = GitLogParser::parseSignedLog(signedLog);
+
+   QCOMPARE(signedCommits.count(), commits.count());
+}
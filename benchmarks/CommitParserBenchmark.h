@@ -0,0 +1,44 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QObject>
+
+/**
+ * @brief The CommitParserBenchmark class measures the parsing of the output of git log into CommitInfo, signed and
+ * unsigned, against the parser used before the byte-level one.
+ */
+class CommitParserBenchmark : public QObject
+{
+   Q_OBJECT
+
+private slots:
+   void legacyParse_data();
+   void legacyParse();
+   void parseUnsignedLog_data();
+   void parseUnsignedLog();
+   void parseSignedLog_data();
+   void parseSignedLog();
+   void sameResult();
+};
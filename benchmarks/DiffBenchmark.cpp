@@ -0,0 +1,77 @@
+#include "DiffBenchmark.h"
+
+#include <DiffHelper.h>
+#include <LogGenerator.h>
+#include <RevisionFiles.h>
+
+#include <QtTest>
+
+void DiffBenchmark::revisionFiles_data()
+{
+   QTest::addColumn<int>("files");
+
+   QTest::newRow("10") << 10;
+   QTest::newRow("1000") << 1000;
+   QTest::newRow("100000") << 100000;
+}
+
+void DiffBenchmark::revisionFiles()
+{
+   QFETCH(int, files);
+
+   const auto diff = LogGenerator::diffTree(files);
+
+   QBENCHMARK
+   {
+      const RevisionFiles revisionFiles(diff);
+      QCOMPARE(revisionFiles.count(), files);
+   }
+}
+
+void DiffBenchmark::revisionFilesLookup_data()
+{
+   revisionFiles_data();
+}
+
+void DiffBenchmark::revisionFilesLookup()
+{
+   QFETCH(int, files);
+
+   const RevisionFiles revisionFiles(LogGenerator::diffTree(files));
+   const auto paths = revisionFiles.getFiles();
+
+   // Every path is looked up once, like when the staged files are matched against the WIP.
+   QBENCHMARK
+   {
+      auto found = 0;
+
+      for (const auto &path : paths)
+         found += revisionFiles.indexOf(path) != -1;
+
+      QCOMPARE(found, files);
+   }
+}
+
+void DiffBenchmark::processDiff_data()
+{
+   QTest::addColumn<int>("lines");
+
+   QTest::newRow("100") << 100;
+   QTest::newRow("10000") << 10000;
+   QTest::newRow("1000000") << 1000000;
+}
+
+void DiffBenchmark::processDiff()
+{
+   QFETCH(int, lines);
+
+   const auto diff = LogGenerator::fileDiff(lines);
+
+   QBENCHMARK
+   {
+      QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> newFileData;
+      QPair<QStringList, QVector<ChunkDiffInfo::ChunkInfo>> oldFileData;
+      const auto info = DiffHelper::processDiff(diff, newFileData, oldFileData);
+      QVERIFY(!info.chunks.isEmpty());
+   }
+}
@@ -0,0 +1,121 @@
+#include "HistoryTest.h"
+
+#include <CommitStore.h>
+#include <GitCache.h>
+#include <GitLogParser.h>
+#include <HistoryCacheFile.h>
+#include <LogGenerator.h>
+#include <WipRevisionInfo.h>
+
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace
+{
+bool runGit(const QString &workingDir, const QStringList &arguments, QByteArray *output = nullptr)
+{
+   QProcess process;
+   process.setWorkingDirectory(workingDir);
+   process.start("git", QStringList { "-c", "user.name=GitQlient", "-c", "user.email=test@gitqlient" } + arguments);
+
+   if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0)
+      return false;
+
+   if (output)
+      *output = process.readAllStandardOutput();
+
+   return true;
+}
+
+// The options of the history command of the GitRepoLoader.
+QStringList logArguments()
+{
+   const auto format = QString("--pretty=format:%1").arg(QString::fromUtf8(GitLogParser::LOG_FORMAT));
+
+   return { "log", "--author-date-order", "--no-color", "--log-size", "--parents", "-z", format };
+}
+}
+
+void HistoryTest::pagedHistory()
+{
+   QTemporaryDir repo;
+   QVERIFY(repo.isValid());
+
+   const auto dir = repo.path();
+
+   if (!runGit(dir, { "init", "-q" }))
+      QSKIP("Git is not available.");
+
+   // Every merge leaves a boundary commit at the end of a page that cuts it.
+   QVERIFY(runGit(dir, { "commit", "-q", "--allow-empty", "-m", "Initial commit" }));
+
+   for (auto i = 0; i < 10; ++i)
+   {
+      QVERIFY(runGit(dir, { "checkout", "-q", "-b", "topic" }));
+      QVERIFY(runGit(dir, { "commit", "-q", "--allow-empty", "-m", QString("Topic %1").arg(i) }));
+      QVERIFY(runGit(dir, { "checkout", "-q", "-" }));
+      QVERIFY(runGit(dir, { "commit", "-q", "--allow-empty", "-m", QString("Main %1").arg(i) }));
+      QVERIFY(runGit(dir, { "merge", "-q", "--no-ff", "-m", QString("Merge %1").arg(i), "topic" }));
+      QVERIFY(runGit(dir, { "branch", "-q", "-D", "topic" }));
+   }
+
+   QByteArray output;
+   QVERIFY(runGit(dir, { "log", "--author-date-order", "--format=%H", "HEAD" }, &output));
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   const auto expected = QString::fromUtf8(output).split('\n', Qt::SkipEmptyParts);
+#else
+   const auto expected = QString::fromUtf8(output).split('\n', QString::SkipEmptyParts);
+#endif
+   const auto pageSize = QString::number((expected.count() + 1) / 2);
+
+   QVERIFY(runGit(dir, logArguments() + QStringList { "-n", pageSize, "HEAD" }, &output));
+
+   GitCache cache;
+   auto commits = GitLogParser::parseUnsignedLog(output);
+   const auto head = commits.isEmpty() ? QString() : commits.constFirst().sha;
+   cache.setup({ head, RevisionFiles(), {} }, std::move(commits));
+
+   // The WIP is not part of the log.
+   const auto skip = QString("--skip=%1").arg(cache.commitCount() - 1);
+   QVERIFY(runGit(dir, logArguments() + QStringList { skip, "-n", pageSize, "HEAD" }, &output));
+
+   cache.appendPage(GitLogParser::parseUnsignedLog(output));
+
+   QStringList loaded;
+
+   for (auto row = 1; row < cache.commitCount(); ++row)
+      loaded.append(cache.commitInfo(row).sha);
+
+   QCOMPARE(loaded, expected);
+}
+
+void HistoryTest::historyCacheRejectsInvalidRows()
+{
+   CommitStore store;
+   QVector<int> rows { CommitStore::INVALID_ID };
+
+   for (const auto &commit : GitLogParser::parseUnsignedLog(LogGenerator::unsignedLog(20)))
+      rows.append(store.insert(commit));
+
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+
+   const HistoryCacheFile file(dir.filePath("history"));
+   const HistoryCacheFile::Header header { QString("log"), {} };
+   HistoryCacheFile::Header readHeader;
+   CommitStore readStore;
+   QVector<int> readRows;
+
+   QVERIFY(file.write(header, store, rows));
+   QVERIFY(file.read(readHeader, readStore, readRows));
+   QCOMPARE(readRows, rows);
+
+   // A row past the commits of the store, as a truncated or stale file would have.
+   rows.append(store.count() + 5);
+
+   QVERIFY(file.write(header, store, rows));
+   QVERIFY(!file.read(readHeader, readStore, readRows));
+   QVERIFY(readRows.isEmpty());
+}
@@ -0,0 +1,146 @@
+#include "LogGenerator.h"
+
+#include <QCryptographicHash>
+#include <QStringList>
+
+namespace
+{
+QByteArray shaFor(int index)
+{
+   return QCryptographicHash::hash(QByteArray::number(index), QCryptographicHash::Sha1).toHex();
+}
+
+QByteArray record(int index, int commits)
+{
+   static const QVector<QByteArray> identities { "Jane Doe<jane.doe@example.com>", "John Roe<john.roe@example.com>",
+                                                 "Alex Poe<alex.poe@example.com>",
+                                                 "Maria Garcia<maria.garcia@example.com>" };
+
+   const auto baseDate = 1600000000;
+
+   QByteArray parents;
+
+   if (index + 1 < commits)
+      parents = shaFor(index + 1);
+
+   if (index % 10 == 0 && index + 2 < commits)
+      parents.append(' ').append(shaFor(index + 2));
+
+   const auto &identity = identities.at(index % identities.count());
+
+   QByteArray record;
+   record.append('>').append(shaFor(index)).append('X').append(parents).append('\n');
+   record.append(identity).append('\n');
+   record.append(identity).append('\n');
+   record.append(QByteArray::number(baseDate - index * 60)).append('\n');
+   record.append("Change number ").append(QByteArray::number(index)).append(" in services/payments/internal\n");
+
+   if (index % 3 == 0)
+      record.append("Longer description of the change.\n\nIt spans several lines to look like a real body.\n");
+
+   record.append(' ');
+
+   return record;
+}
+}
+
+namespace LogGenerator
+{
+QByteArray unsignedLog(int commits)
+{
+   QByteArray log;
+   log.reserve(commits * 320);
+
+   for (auto i = 0; i < commits; ++i)
+   {
+      const auto data = record(i, commits);
+
+      if (i != 0)
+         log.append('\0');
+
+      log.append("log size ").append(QByteArray::number(data.size())).append('\n').append(data);
+   }
+
+   return log;
+}
+
+QByteArray signedLog(int commits)
+{
+   QByteArray log;
+   log.reserve(commits * 420);
+
+   for (auto i = 0; i < commits; ++i)
+   {
+      const auto data = record(i, commits);
+
+      if (i != 0)
+         log.append('\0');
+
+      if (i % 2 == 0)
+      {
+         log.append("gpg: Signature made Sun Sep 13 12:26:40 2020 CEST\n");
+         log.append("gpg:                using RSA key 4AEE18F83AFDEB23\n");
+         log.append("gpg: Good signature from \"Jane Doe <jane.doe@example.com>\" [ultimate]\n");
+      }
+
+      log.append("log size ").append(QByteArray::number(data.size())).append('\n').append(data);
+   }
+
+   return log;
+}
+
+QString diffTree(int files)
+{
+   static const QStringList statuses { "M", "M", "M", "A", "D" };
+
+   QString diff;
+
+   for (auto i = 0; i < files; ++i)
+   {
+      diff.append(QString(":100644 100644 %1 %2 %3\tsrc/module%4/File%5.cpp\n")
+                      .arg(QString::fromLatin1(shaFor(2 * i)), QString::fromLatin1(shaFor(2 * i + 1)),
+                           statuses.at(i % statuses.count()))
+                      .arg(i / 20)
+                      .arg(i));
+   }
+
+   return diff;
+}
+
+QString fileDiff(int lines)
+{
+   QString diff;
+
+   for (auto i = 0; i < lines; ++i)
+   {
+      const auto text = QString("   auto value%1 = compute(%1);").arg(i);
+
+      if (i % 7 == 3)
+         diff.append('-').append(text).append('\n');
+      else if (i % 7 == 5)
+         diff.append('+').append(text).append('\n');
+      else
+         diff.append(' ').append(text).append('\n');
+   }
+
+   return diff;
+}
+
+QVector<int> historySizes()
+{
+   const auto sizes = QString::fromLocal8Bit(qgetenv("GITQLIENT_BENCHMARK_SIZES"));
+
+   if (sizes.isEmpty())
+      return { 10000, 100000, 1000000 };
+
+   QVector<int> values;
+
+   for (const auto &size : sizes.split(','))
+   {
+      if (const auto value = size.trimmed().toInt(); value > 0)
+         values.append(value);
+   }
+
+   return values;
+}
+}
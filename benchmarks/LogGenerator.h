@@ -0,0 +1,70 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The LogGenerator namespace creates synthetic inputs with the same format the GitRepoLoader receives from
+ * Git. The output is deterministic so the results of different runs can be compared.
+ */
+namespace LogGenerator
+{
+/**
+ * @brief Generates the output of the git log command used by the GitRepoLoader for a history with @p commits
+ * revisions. Every 10th commit is a merge of a short-lived branch.
+ *
+ * @param commits The number of revisions.
+ * @return The NUL-delimited log.
+ */
+QByteArray unsignedLog(int commits);
+
+/**
+ * @brief Generates the same history as unsignedLog() in the format used when the signatures are shown. Every other
+ * commit is signed.
+ *
+ * @param commits The number of revisions.
+ * @return The log with the GPG lines before every signed commit.
+ */
+QByteArray signedLog(int commits);
+
+/**
+ * @brief Generates the raw output of git diff-tree for a revision that touches @p files files.
+ */
+QString diffTree(int files);
+
+/**
+ * @brief Generates the hunks of the diff of a file with @p lines lines, with an addition and a deletion every few
+ * lines.
+ */
+QString fileDiff(int lines);
+
+/**
+ * @brief The sizes of the histories the benchmarks run with: 10k, 100k and 1M commits. The environment variable
+ * GITQLIENT_BENCHMARK_SIZES overrides them with a comma-separated list.
+ */
+QVector<int> historySizes();
+}
@@ -0,0 +1,70 @@
+#General stuff
+QT += core widgets concurrent testlib
+
+CONFIG += console c++17 c++1z testcase
+CONFIG -= app_bundle
+
+TARGET = gitqlient-benchmarks
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include($$PWD/../QLogger/QLogger.pri)
+
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/../src/cache \
+    $$PWD/../src/diff \
+    $$PWD/../src/git \
+    $$PWD/../src/tracing
+
+HEADERS += \
+    $$PWD/../src/cache/CommitInfo.h \
+    $$PWD/../src/cache/CommitStore.h \
+    $$PWD/../src/cache/GitCache.h \
+    $$PWD/../src/cache/HistoryCacheFile.h \
+    $$PWD/../src/cache/Identity.h \
+    $$PWD/../src/cache/Lane.h \
+    $$PWD/../src/cache/LaneType.h \
+    $$PWD/../src/cache/ObjectId.h \
+    $$PWD/../src/cache/PathTable.h \
+    $$PWD/../src/cache/References.h \
+    $$PWD/../src/cache/RevisionFiles.h \
+    $$PWD/../src/cache/WipRevisionInfo.h \
+    $$PWD/../src/cache/lanes.h \
+    $$PWD/../src/diff/DiffHelper.h \
+    $$PWD/../src/diff/DiffInfo.h \
+    $$PWD/../src/git/GitLogParser.h \
+    $$PWD/../src/tracing/Tracer.h \
+    $$PWD/BenchmarkReport.h \
+    $$PWD/CacheBenchmark.h \
+    $$PWD/CommitParserBenchmark.h \
+    $$PWD/DiffBenchmark.h \
+    $$PWD/HistoryTest.h \
+    $$PWD/LogGenerator.h
+
+SOURCES += \
+    $$PWD/../src/cache/CommitInfo.cpp \
+    $$PWD/../src/cache/CommitStore.cpp \
+    $$PWD/../src/cache/GitCache.cpp \
+    $$PWD/../src/cache/HistoryCacheFile.cpp \
+    $$PWD/../src/cache/Lane.cpp \
+    $$PWD/../src/cache/PathTable.cpp \
+    $$PWD/../src/cache/References.cpp \
+    $$PWD/../src/cache/RevisionFiles.cpp \
+    $$PWD/../src/cache/lanes.cpp \
+    $$PWD/../src/git/GitLogParser.cpp \
+    $$PWD/../src/tracing/Tracer.cpp \
+    $$PWD/BenchmarkReport.cpp \
+    $$PWD/CacheBenchmark.cpp \
+    $$PWD/CommitParserBenchmark.cpp \
+    $$PWD/DiffBenchmark.cpp \
+    $$PWD/HistoryTest.cpp \
+    $$PWD/LogGenerator.cpp \
+    $$PWD/main.cpp
+
+DEFINES += \
+   QT_NO_JAVA_STYLE_ITERATORS \
+   QT_NO_CAST_TO_ASCII \
+   QT_RESTRICTED_CAST_FROM_ASCII \
+   QT_DISABLE_DEPRECATED_BEFORE=0x050900 \
+   QT_USE_QSTRINGBUILDER
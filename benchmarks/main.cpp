@@ -0,0 +1,58 @@
+#include <BenchmarkReport.h>
+#include <CacheBenchmark.h>
+#include <CommitParserBenchmark.h>
+#include <DiffBenchmark.h>
+#include <HistoryTest.h>
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <memory>
+#include <vector>
+
+// Runs all the benchmarks and the history checks. The arguments are passed to QTest, except "-json <file>" that also
+// writes all the results into a single JSON file.
+int main(int argc, char *argv[])
+{
+   QCoreApplication app(argc, argv);
+
+   auto arguments = app.arguments();
+   QString jsonFile;
+
+   if (const auto index = arguments.indexOf("-json"); index != -1 && index + 1 < arguments.count())
+   {
+      jsonFile = arguments.at(index + 1);
+      arguments.removeAt(index + 1);
+      arguments.removeAt(index);
+   }
+
+   std::vector<std::unique_ptr<QObject>> benchmarks;
+   benchmarks.push_back(std::make_unique<CommitParserBenchmark>());
+   benchmarks.push_back(std::make_unique<CacheBenchmark>());
+   benchmarks.push_back(std::make_unique<DiffBenchmark>());
+   benchmarks.push_back(std::make_unique<HistoryTest>());
+
+   QTemporaryDir xmlDir;
+   BenchmarkReport report;
+   auto status = 0;
+
+   for (const auto &benchmark : benchmarks)
+   {
+      auto benchmarkArguments = arguments;
+      const auto xmlFile = xmlDir.filePath(QString("%1.xml").arg(benchmark->metaObject()->className()));
+
+      if (!jsonFile.isEmpty())
+         benchmarkArguments << "-o" << "-,txt" << "-o" << QString("%1,xml").arg(xmlFile);
+
+      status |= QTest::qExec(benchmark.get(), benchmarkArguments);
+
+      if (!jsonFile.isEmpty() && !report.append(xmlFile))
+         status |= 1;
+   }
+
+   if (!jsonFile.isEmpty() && !report.write(jsonFile))
+      status |= 1;
+
+   return status;
+}
@@ -11,6 +11,7 @@ include($$PWD/git_server/GitServer.pri)
 include($$PWD/git_server/GitServerWidgets.pri)
 include($$PWD/QPinnableTabWidget/QPinnableTabWidget.pri)
 include($$PWD/jenkins/Jenkins.pri)
+include($$PWD/tracing/Tracing.pri)
 
 RESOURCES += \
     $$PWD/resources.qrc
@@ -5,6 +5,7 @@
 #include <GitBranches.h>
 #include <GitCache.h>
 #include <GitConfig.h>
+#include <GitFuture.h>
 #include <GitQlientStyles.h>
 #include <GitStashes.h>
 
@@ -80,6 +81,8 @@ void BranchDlg::accept()
 {
    if (ui->leNewName->text() == ui->leOldName->text() && mConfig.mDialogMode != BranchDlgMode::PUSH_UPSTREAM)
       ui->leNewName->setStyleSheet("border: 1px solid red;");
+   else if (mConfig.mDialogMode == BranchDlgMode::PUSH_UPSTREAM)
+      pushUpstream();
    else
    {
       QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
@@ -161,43 +164,64 @@ void BranchDlg::accept()
          QScopedPointer<GitStashes> git(new GitStashes(mConfig.mGit));
          ret = git->stashBranch(ui->leOldName->text(), ui->leNewName->text());
       }
-      else if (mConfig.mDialogMode == BranchDlgMode::PUSH_UPSTREAM)
+
+      QApplication::restoreOverrideCursor();
+
+      showResult(ret);
+   }
+}
+
+void BranchDlg::reject()
+{
+   // Closing the dialog stops the push if it's still running.
+   mPushUpstream.cancel();
+
+   QDialog::reject();
+}
+
+void BranchDlg::pushUpstream()
+{
+   ui->pbAccept->setEnabled(false);
+   ui->leNewName->setEnabled(false);
+
+   QScopedPointer<GitBranches> git(new GitBranches(mConfig.mGit));
+   mPushUpstream = git->pushUpstreamAsync(ui->leNewName->text());
+
+   GitFuture::then(mPushUpstream, this, [this](const GitExecResult &ret) {
+      if (ret.success)
       {
-         ret = git->pushUpstream(ui->leNewName->text());
+         QScopedPointer<GitConfig> git(new GitConfig(mConfig.mGit));
+         const auto remote = git->getRemoteForBranch(ui->leNewName->text());
 
-         if (ret.success)
+         if (remote.success)
          {
-            QScopedPointer<GitConfig> git(new GitConfig(mConfig.mGit));
-            const auto remote = git->getRemoteForBranch(ui->leNewName->text());
-
-            if (remote.success)
-            {
-               const auto sha = mConfig.mCache->getShaOfReference(ui->leOldName->text(), References::Type::LocalBranch);
-               mConfig.mCache->insertReference(sha, References::Type::RemoteBranches,
-                                               QString("%1/%2").arg(remote.output, ui->leNewName->text()));
-               emit mConfig.mCache->signalCacheUpdated();
-            }
+            const auto sha = mConfig.mCache->getShaOfReference(ui->leOldName->text(), References::Type::LocalBranch);
+            mConfig.mCache->insertReference(sha, References::Type::RemoteBranches,
+                                            QString("%1/%2").arg(remote.output, ui->leNewName->text()));
+            emit mConfig.mCache->signalCacheUpdated();
          }
       }
 
-      QApplication::restoreOverrideCursor();
+      showResult(ret);
+   });
+}
 
-      if (!ret.success)
-      {
-         QDialog::reject();
-
-         QMessageBox msgBox(
-             QMessageBox::Critical, tr("Error on branch action!"),
-             QString(tr("There were problems during the branch operation. Please, see the detailed description "
-                        "for more information.")),
-             QMessageBox::Ok, this);
-         msgBox.setDetailedText(ret.output);
-         msgBox.setStyleSheet(GitQlientStyles::getStyles());
-         msgBox.exec();
-      }
-      else
-         QDialog::accept();
+void BranchDlg::showResult(const GitExecResult &ret)
+{
+   if (!ret.success)
+   {
+      QDialog::reject();
+
+      QMessageBox msgBox(QMessageBox::Critical, tr("Error on branch action!"),
+                         QString(tr("There were problems during the branch operation. Please, see the detailed "
+                                    "description for more information.")),
+                         QMessageBox::Ok, this);
+      msgBox.setDetailedText(ret.output);
+      msgBox.setStyleSheet(GitQlientStyles::getStyles());
+      msgBox.exec();
    }
+   else
+      QDialog::accept();
 }
 
 void BranchDlg::copyBranchName()
@@ -23,7 +23,10 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitExecResult.h>
+
 #include <QDialog>
+#include <QFuture>
 
 namespace Ui
 {
@@ -108,6 +111,7 @@ public:
 private:
    Ui::BranchDlg *ui = nullptr;
    BranchDlgConfig mConfig;
+   QFuture<GitExecResult> mPushUpstream;
 
    /**
     * @brief Validates that the new branch name is not the same for the creation and renaming cases. If the user is
@@ -118,6 +122,18 @@ private:
     * @brief Executes the Git actions based on the configuration once the validation as taken place.
     */
    void accept() override;
+   /**
+    * @brief Closes the dialog and cancels the push if it's running.
+    */
+   void reject() override;
+   /**
+    * @brief Pushes the branch to the remote without blocking the UI. The dialog is closed when git finishes.
+    */
+   void pushUpstream();
+   /**
+    * @brief Closes the dialog with the result of the branch operation, showing the error if it failed.
+    */
+   void showResult(const GitExecResult &ret);
 
    /**
     * @brief copyBranchName Copies the current remote branch name into the line edit so the user doesn't have to type
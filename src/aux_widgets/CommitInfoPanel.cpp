@@ -55,9 +55,8 @@ void CommitInfoPanel::configure(const CommitInfo &commit)
 {
    mLabelSha->setText(commit.sha);
 
-   const auto authorName = commit.committer.split("<").first();
    mLabelTitle->setText(commit.shortLog);
-   mLabelAuthor->setText(authorName);
+   mLabelAuthor->setText(commit.committer.name);
 
    QDateTime commitDate = QDateTime::fromSecsSinceEpoch(commit.dateSinceEpoch.count());
    mLabelDateTime->setText(commitDate.toString("dd/MM/yyyy hh:mm"));
@@ -6,6 +6,7 @@
 #include <CommitHistoryView.h>
 #include <CommitInfo.h>
 #include <FileBlameWidget.h>
+#include <GitFuture.h>
 #include <GitHistory.h>
 #include <RepositoryViewDelegate.h>
 
@@ -104,53 +105,65 @@ void BlameWidget::init(const QString &workingDirectory)
 
 void BlameWidget::showFileHistory(const QString &filePath)
 {
-   if (!mTabsMap.contains(filePath))
+   if (mTabsMap.contains(filePath))
    {
-      QScopedPointer<GitHistory> git(new GitHistory(mGit));
-      auto ret = git->history(filePath);
+      mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+      return;
+   }
 
-      if (ret.success)
+   QScopedPointer<GitHistory> git(new GitHistory(mGit));
+
+   GitFuture::then(git->historyAsync(filePath), this, [this, filePath](const GitExecResult &ret) {
+      // The file could have been opened again while its history was loading.
+      if (mTabsMap.contains(filePath))
       {
+         mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+         return;
+      }
+
+      if (ret.success && !ret.output.isEmpty())
+         addFileHistory(filePath, ret.output);
+   });
+}
+
+void BlameWidget::addFileHistory(const QString &filePath, const QString &history)
+{
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-         auto shaHistory = ret.output.split("\n", Qt::SkipEmptyParts);
+   auto shaHistory = history.split("\n", Qt::SkipEmptyParts);
 #else
-         auto shaHistory = ret.output.split("\n", QString::SkipEmptyParts);
+   auto shaHistory = history.split("\n", QString::SkipEmptyParts);
 #endif
-         for (auto i = 0; i < shaHistory.size();)
-         {
-            if (shaHistory.at(i).startsWith("gpg:"))
-            {
-               shaHistory.takeAt(i);
+   for (auto i = 0; i < shaHistory.size();)
+   {
+      if (shaHistory.at(i).startsWith("gpg:"))
+      {
+         shaHistory.takeAt(i);
 
-               if (shaHistory.size() <= i)
-                  break;
-            }
-            else
-               ++i;
-         }
+         if (shaHistory.size() <= i)
+            break;
+      }
+      else
+         ++i;
+   }
 
-         mRepoView->blockSignals(true);
-         mRepoView->filterBySha(shaHistory);
-         mRepoView->blockSignals(false);
+   mRepoView->blockSignals(true);
+   mRepoView->filterBySha(shaHistory);
+   mRepoView->blockSignals(false);
 
-         const auto previousSha = shaHistory.count() > 1 ? shaHistory.at(1) : QString(tr("No info"));
-         const auto fileBlameWidget = new FileBlameWidget(mCache, mGit);
+   const auto previousSha = shaHistory.count() > 1 ? shaHistory.at(1) : QString(tr("No info"));
+   const auto fileBlameWidget = new FileBlameWidget(mCache, mGit);
 
-         fileBlameWidget->setup(filePath, shaHistory.constFirst(), previousSha);
-         connect(fileBlameWidget, &FileBlameWidget::signalCommitSelected, mRepoView, &CommitHistoryView::focusOnCommit);
+   fileBlameWidget->setup(filePath, shaHistory.constFirst(), previousSha);
+   connect(fileBlameWidget, &FileBlameWidget::signalCommitSelected, mRepoView, &CommitHistoryView::focusOnCommit);
 
-         const auto index = mTabWidget->addTab(fileBlameWidget, filePath.split("/").last());
-         mTabWidget->setTabsClosable(true);
-         mTabWidget->blockSignals(true);
-         mTabWidget->setCurrentIndex(index);
-         mTabWidget->blockSignals(false);
+   const auto index = mTabWidget->addTab(fileBlameWidget, filePath.split("/").last());
+   mTabWidget->setTabsClosable(true);
+   mTabWidget->blockSignals(true);
+   mTabWidget->setCurrentIndex(index);
+   mTabWidget->blockSignals(false);
 
-         mLastTabIndex = index;
-         mTabsMap.insert(filePath, fileBlameWidget);
-      }
-   }
-   else
-      mTabWidget->setCurrentWidget(mTabsMap.value(filePath));
+   mLastTabIndex = index;
+   mTabsMap.insert(filePath, fileBlameWidget);
 }
 
 void BlameWidget::onNewRevisions(int totalCommits)
@@ -98,6 +98,8 @@ public:
     * @brief Opens the blame for a given file. This method configures both the history view, where the user can check
     * all the commits where this file has been modified and also adds a tab in the central QTabWidget.
     *
+    * The history is loaded asynchronously, so the tab is added once git finishes.
+    *
     * @param filePath The full file path.
     */
    void showFileHistory(const QString &filePath);
@@ -131,6 +133,13 @@ private:
     * @param index The index from the file system model.
     */
    void showFileHistoryByIndex(const QModelIndex &index);
+   /**
+    * @brief Filters the history view by the commits of the file and opens its blame in a new tab.
+    *
+    * @param filePath The full file path.
+    * @param history The output of git log with the SHAs of the commits that modified the file.
+    */
+   void addFileHistory(const QString &filePath, const QString &history);
    /**
     * @brief Shows the context menu for the history view.
     *
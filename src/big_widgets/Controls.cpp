@@ -4,6 +4,7 @@
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitConfig.h>
+#include <GitFuture.h>
 #include <GitQlientSettings.h>
 #include <GitQlientStyles.h>
 #include <GitQlientUpdater.h>
@@ -13,7 +14,6 @@
 #include <PomodoroButton.h>
 #include <QLogger.h>
 
-#include <QApplication>
 #include <QButtonGroup>
 #include <QHBoxLayout>
 #include <QMenu>
@@ -203,6 +203,8 @@ Controls::Controls(const QSharedPointer<GitCache> &cache, const QSharedPointer<G
 
 Controls::~Controls()
 {
+   mRemoteOperation.cancel();
+
    delete mBtnGroup;
 }
 
@@ -235,50 +237,68 @@ void Controls::enableButtons(bool enabled)
 
 void Controls::pullCurrentBranch()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   if (mRemoteOperation.isRunning())
+      return;
+
    QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->pull();
-   QApplication::restoreOverrideCursor();
 
-   if (ret.success)
-   {
-      if (ret.output.contains("merge conflict", Qt::CaseInsensitive))
-         emit signalPullConflict();
-      else
-         emit requestFullReload();
-   }
-   else
-   {
-      if (ret.output.contains("error: could not apply", Qt::CaseInsensitive)
-          && ret.output.contains("causing a conflict", Qt::CaseInsensitive))
+   runRemoteOperation(git->pullAsync(), [this](const GitExecResult &ret) {
+      if (ret.success)
       {
-         emit signalPullConflict();
+         if (ret.output.contains("merge conflict", Qt::CaseInsensitive))
+            emit signalPullConflict();
+         else
+            emit requestFullReload();
       }
       else
       {
-         QMessageBox msgBox(QMessageBox::Critical, tr("Error while pulling"),
-                            QString(tr("There were problems during the pull operation. Please, see the detailed "
-                                       "description for more information.")),
-                            QMessageBox::Ok, this);
-         msgBox.setDetailedText(ret.output);
-         msgBox.setStyleSheet(GitQlientStyles::getStyles());
-         msgBox.exec();
+         if (ret.output.contains("error: could not apply", Qt::CaseInsensitive)
+             && ret.output.contains("causing a conflict", Qt::CaseInsensitive))
+         {
+            emit signalPullConflict();
+         }
+         else
+         {
+            QMessageBox msgBox(QMessageBox::Critical, tr("Error while pulling"),
+                               QString(tr("There were problems during the pull operation. Please, see the detailed "
+                                          "description for more information.")),
+                               QMessageBox::Ok, this);
+            msgBox.setDetailedText(ret.output);
+            msgBox.setStyleSheet(GitQlientStyles::getStyles());
+            msgBox.exec();
+         }
       }
-   }
+   });
 }
 
 void Controls::fetchAll()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-   QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->fetch();
-   QApplication::restoreOverrideCursor();
+   fetch(GitScheduler::Priority::Interactive);
+}
+
+void Controls::autoFetch()
+{
+   fetch(GitScheduler::Priority::Background);
+}
 
-   if (ret)
+void Controls::fetch(GitScheduler::Priority priority)
+{
+   // The automatic fetch doesn't pile up when the previous operation is slow.
+   if (mRemoteOperation.isRunning())
    {
-      mGitTags->getRemoteTags();
-      emit requestFullReload();
+      QLog_Debug("UI", "Fetch skipped: there is a remote operation running.");
+      return;
    }
+
+   QScopedPointer<GitRemote> git(new GitRemote(mGit));
+
+   runRemoteOperation(git->fetchAsync(priority), [this](const GitExecResult &ret) {
+      if (ret.success)
+      {
+         mGitTags->getRemoteTags();
+         emit requestFullReload();
+      }
+   });
 }
 
 void Controls::activateMergeWarning()
@@ -308,11 +328,16 @@ ControlsMainViews Controls::getCurrentSelectedButton() const
 
 void Controls::pushCurrentBranch()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   if (mRemoteOperation.isRunning())
+      return;
+
    QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->push();
-   QApplication::restoreOverrideCursor();
 
+   runRemoteOperation(git->pushAsync(), [this](const GitExecResult &ret) { onPushFinished(ret); });
+}
+
+void Controls::onPushFinished(const GitExecResult &ret)
+{
    if (ret.output.contains("has no upstream branch"))
    {
       const auto currentBranch = mGit->getCurrentBranch();
@@ -356,13 +381,33 @@ void Controls::pushCurrentBranch()
 
 void Controls::pruneBranches()
 {
-   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   if (mRemoteOperation.isRunning())
+      return;
+
    QScopedPointer<GitRemote> git(new GitRemote(mGit));
-   const auto ret = git->prune();
-   QApplication::restoreOverrideCursor();
 
-   if (ret.success)
-      emit requestReferencesReload();
+   runRemoteOperation(git->pruneAsync(), [this](const GitExecResult &ret) {
+      if (ret.success)
+         emit requestReferencesReload();
+   });
+}
+
+void Controls::runRemoteOperation(const QFuture<GitExecResult> &operation,
+                                  std::function<void(const GitExecResult &)> onFinished)
+{
+   mRemoteOperation = operation;
+
+   mPullBtn->setEnabled(false);
+   mPullOptions->setEnabled(false);
+   mPushBtn->setEnabled(false);
+
+   GitFuture::then(operation, this, [this, onFinished](const GitExecResult &ret) {
+      mPullBtn->setEnabled(true);
+      mPullOptions->setEnabled(true);
+      mPushBtn->setEnabled(true);
+
+      onFinished(ret);
+   });
 }
 
 void Controls::createGitPlatformButton(QHBoxLayout *layout)
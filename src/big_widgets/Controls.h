@@ -23,7 +23,13 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
+#include <GitExecResult.h>
+#include <GitScheduler.h>
+
 #include <QFrame>
+#include <QFuture>
+
+#include <functional>
 
 class QToolButton;
 class QPushButton;
@@ -155,6 +161,11 @@ public:
 
    */
    void fetchAll();
+   /*!
+    \brief Performs the periodic fetch. It runs behind the commands the user is waiting for.
+
+   */
+   void autoFetch();
    /*!
     \brief Activates the merge warning frame.
 
@@ -203,6 +214,23 @@ private:
    GitQlientUpdater *mUpdater = nullptr;
    QButtonGroup *mBtnGroup = nullptr;
    bool mGoGitServerView = false;
+   QFuture<GitExecResult> mRemoteOperation;
+
+   /**
+    * @brief runRemoteOperation Waits for a pull, push or fetch without blocking the UI. Only one of them runs at a
+    * time and it's canceled if the widget is destroyed.
+    *
+    * @param operation The future of the operation.
+    * @param onFinished The continuation that receives the result.
+    */
+   void runRemoteOperation(const QFuture<GitExecResult> &operation,
+                           std::function<void(const GitExecResult &)> onFinished);
+   /**
+    * @brief fetch Fetches all the remotes and reloads the repository when it succeeds.
+    *
+    * @param priority The priority of the fetch in the GitScheduler.
+    */
+   void fetch(GitScheduler::Priority priority);
 
    /*!
     \brief Pulls the current branch.
@@ -214,6 +242,11 @@ private:
 
    */
    void pushCurrentBranch();
+   /*!
+    \brief Handles the result of the push: asks for the upstream branch if it doesn't have one.
+
+   */
+   void onPushFinished(const GitExecResult &ret);
    /*!
     \brief Prunes all branches, tags and stashes.
 
@@ -10,6 +10,7 @@
 #include <InitialRepoConfig.h>
 #include <ProgressDlg.h>
 #include <QPinnableTabWidget.h>
+#include <Tracer.h>
 
 #include <QCommandLineParser>
 #include <QEvent>
@@ -262,6 +263,10 @@ bool GitQlient::parseArguments(const QStringList &arguments, QStringList *repos)
    const QCommandLineOption logLevelOption("log-level", tr("Sets log level."), tr("level"));
    parser.addOption(logLevelOption);
 
+   const QCommandLineOption traceOption("trace", tr("Writes a Chrome trace of the application into a file."),
+                                        tr("file"));
+   parser.addOption(traceOption);
+
    parser.process(arguments);
 
    *repos = parser.positionalArguments();
@@ -298,6 +303,12 @@ bool GitQlient::parseArguments(const QStringList &arguments, QStringList *repos)
    const auto manager = QLoggerManager::getInstance();
    manager->addDestination("GitQlient.log", { "UI", "Git", "Cache" }, logLevel);
 
+   const auto traceFile
+       = parser.isSet(traceOption) ? parser.value(traceOption) : settings.globalValue("traceFile", "").toString();
+
+   if (ret && !traceFile.isEmpty())
+      Tracer::getInstance()->start(traceFile);
+
    return ret;
 }
 
@@ -18,6 +18,7 @@
 #include <GitMerge.h>
 #include <GitQlientSettings.h>
 #include <GitRepoLoader.h>
+#include <GitRepoWatcher.h>
 #include <GitServerCache.h>
 #include <GitServerWidget.h>
 #include <GitSubmodules.h>
@@ -60,7 +61,7 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    , mJenkins(new JenkinsWidget(mGitBase))
    , mConfigWidget(new ConfigWidget(mGitBase))
    , mAutoFetch(new QTimer())
-   , mAutoFilesUpdate(new QTimer())
+   , mRepoWatcher(new GitRepoWatcher(mGitBase, this))
    , mGitTags(new GitTags(mGitBase, mGitQlientCache))
 {
    setAttribute(Qt::WA_DeleteOnClose);
@@ -106,10 +107,9 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    const auto fetchInterval = mSettings->localValue("AutoFetch", 5).toInt();
 
    mAutoFetch->setInterval(fetchInterval * 60 * 1000);
-   mAutoFilesUpdate->setInterval(15000);
 
-   connect(mAutoFetch, &QTimer::timeout, mControls, &Controls::fetchAll);
-   connect(mAutoFilesUpdate, &QTimer::timeout, this, &GitQlientRepo::updateUiFromWatcher);
+   connect(mAutoFetch, &QTimer::timeout, mControls, &Controls::autoFetch);
+   connect(mRepoWatcher, &GitRepoWatcher::workingTreeChanged, this, &GitQlientRepo::updateUiFromWatcher);
 
    connect(mControls, &Controls::requestFullReload, this, &GitQlientRepo::fullReload);
    connect(mControls, &Controls::requestReferencesReload, this, &GitQlientRepo::referencesReload);
@@ -125,6 +125,9 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
    connect(mControls, &Controls::signalPullConflict, this, &GitQlientRepo::showWarningMerge);
 
    connect(mHistoryWidget, &HistoryWidget::signalAllBranchesActive, mGitLoader.data(), &GitRepoLoader::setShowAll);
+   connect(mHistoryWidget, &HistoryWidget::signalNextPageRequested, mGitLoader.data(), &GitRepoLoader::loadNextPage);
+   connect(mHistoryWidget, &HistoryWidget::signalCommitTextsRequested, mGitLoader.data(),
+           &GitRepoLoader::loadCommitTexts);
    connect(mHistoryWidget, &HistoryWidget::fullReload, this, &GitQlientRepo::fullReload);
    connect(mHistoryWidget, &HistoryWidget::referencesReload, this, &GitQlientRepo::referencesReload);
    connect(mHistoryWidget, &HistoryWidget::logReload, this, &GitQlientRepo::logReload);
@@ -169,6 +172,11 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
 
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingStarted, this, &GitQlientRepo::createProgressDialog);
    connect(mGitLoader.data(), &GitRepoLoader::signalLoadingFinished, this, &GitQlientRepo::onRepoLoadFinished);
+   connect(mGitLoader.data(), &GitRepoLoader::signalRevisionsAppended, this, &GitQlientRepo::onRevisionsAppended);
+   connect(mGitLoader.data(), &GitRepoLoader::signalRevisionsInserted, this, &GitQlientRepo::onRevisionsInserted);
+   connect(mGitLoader.data(), &GitRepoLoader::signalPageLoaded, mHistoryWidget, &HistoryWidget::appendGraphRows);
+   connect(mGitLoader.data(), &GitRepoLoader::signalCommitTextsLoaded, mHistoryWidget,
+           &HistoryWidget::onCommitTextsLoaded);
 
    m_loaderThread = new QThread();
    mGitLoader->moveToThread(m_loaderThread);
@@ -184,7 +192,6 @@ GitQlientRepo::GitQlientRepo(const QSharedPointer<GitBase> &git, const QSharedPo
 GitQlientRepo::~GitQlientRepo()
 {
    delete mAutoFetch;
-   delete mAutoFilesUpdate;
 
    m_loaderThread->exit();
    m_loaderThread->wait();
@@ -196,12 +203,14 @@ QString GitQlientRepo::currentBranch() const
    return mGitBase->getCurrentBranch();
 }
 
-void GitQlientRepo::updateUiFromWatcher()
+void GitQlientRepo::updateUiFromWatcher(const QStringList &directories)
 {
    QLog_Info("UI", QString("Updating the GitQlient UI from watcher"));
 
    QScopedPointer<GitWip> git(new GitWip(mGitBase, mGitQlientCache));
-   git->updateWip();
+   git->updateWip(directories);
+
+   mRepoWatcher->ignoreGitDirChanges();
 
    mHistoryWidget->updateUiFromWatcher();
 
@@ -286,7 +295,7 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
 
       mControls->enableButtons(true);
 
-      mAutoFilesUpdate->start();
+      mRepoWatcher->start();
 
       QScopedPointer<GitConfig> git(new GitConfig(mGitBase));
 
@@ -307,7 +316,16 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
    const auto totalCommits = mGitQlientCache->commitCount();
 
    mHistoryWidget->loadBranches(fullReload);
-   mHistoryWidget->updateGraphView(totalCommits);
+
+   if (mRevisionsStreamed)
+   {
+      mRevisionsStreamed = false;
+      mHistoryWidget->appendGraphRows(totalCommits);
+   }
+   else if (mRevisionsInserted)
+      mRevisionsInserted = false;
+   else
+      mHistoryWidget->updateGraphView(totalCommits);
 
    mBlameWidget->onNewRevisions(totalCommits);
 
@@ -337,6 +355,29 @@ void GitQlientRepo::onRepoLoadFinished(bool fullReload)
    emit currentBranchChanged();
 }
 
+void GitQlientRepo::onRevisionsAppended(int totalCommits)
+{
+   if (!mRevisionsStreamed)
+   {
+      mRevisionsStreamed = true;
+
+      if (mWaitDlg)
+         mWaitDlg->close();
+
+      mHistoryWidget->setEnabled(true);
+      mHistoryWidget->updateGraphView(totalCommits);
+   }
+   else
+      mHistoryWidget->appendGraphRows(totalCommits);
+}
+
+void GitQlientRepo::onRevisionsInserted(const QVector<int> &rows)
+{
+   mRevisionsInserted = true;
+
+   mHistoryWidget->insertGraphRows(rows);
+}
+
 void GitQlientRepo::loadFileDiff(const QString &currentSha, const QString &previousSha, const QString &file,
                                  bool isCached)
 {
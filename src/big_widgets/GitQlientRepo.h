@@ -31,6 +31,7 @@ class GitBase;
 class GitQlientSettings;
 class GitCache;
 class GitRepoLoader;
+class GitRepoWatcher;
 class QCloseEvent;
 class QStackedLayout;
 class Controls;
@@ -161,7 +162,7 @@ private:
    Jenkins::JenkinsWidget *mJenkins = nullptr;
    ConfigWidget *mConfigWidget = nullptr;
    QTimer *mAutoFetch = nullptr;
-   QTimer *mAutoFilesUpdate = nullptr;
+   GitRepoWatcher *mRepoWatcher = nullptr;
    QTimer *mAutoPrUpdater = nullptr;
    QPointer<WaitingDlg> mWaitDlg;
    QPair<ControlsMainViews, QWidget *> mPreviousView;
@@ -169,13 +170,16 @@ private:
    QSharedPointer<GitTags> mGitTags;
 
    bool mIsInit = false;
+   bool mRevisionsStreamed = false;
+   bool mRevisionsInserted = false;
    QThread *m_loaderThread;
 
    /*!
-    \brief Performs a light UI update triggered by the QFileSystemWatcher.
+    \brief Performs a light UI update triggered by the GitRepoWatcher.
 
+    \param directories The directories that changed. If it's empty, the whole WIP is updated.
    */
-   void updateUiFromWatcher();
+   void updateUiFromWatcher(const QStringList &directories);
    /*!
     \brief Opens the diff view with the selected commit from the repository view.
     \param currentSha The current selected commit SHA.
@@ -221,6 +225,18 @@ private:
     * @param fullReload Indicates that the load finished in the full mode (commits + references).
     */
    void onRepoLoadFinished(bool fullReload);
+   /*!
+    \brief Shows the revisions that are already in the cache while the rest of the history is still loading.
+
+    \param totalCommits The total of revisions in the cache.
+   */
+   void onRevisionsAppended(int totalCommits);
+   /*!
+    \brief Updates the graph with the revisions found by an incremental reload instead of resetting it.
+
+    \param rows The positions of the new revisions in the graph.
+   */
+   void onRevisionsInserted(const QVector<int> &rows);
    /*!
     \brief Loads the view to show the diff of a specific file.
 
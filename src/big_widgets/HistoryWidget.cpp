@@ -143,6 +143,7 @@ HistoryWidget::HistoryWidget(const QSharedPointer<GitCache> &cache, const QShare
    connect(mRepositoryView, &CommitHistoryView::signalCherryPickConflict, this,
            &HistoryWidget::signalCherryPickConflict);
    connect(mRepositoryView, &CommitHistoryView::signalPullConflict, this, &HistoryWidget::signalPullConflict);
+   connect(mRepositoryView, &CommitHistoryView::signalNextPageRequested, this, &HistoryWidget::signalNextPageRequested);
    connect(mRepositoryView, &CommitHistoryView::showPrDetailedView, this, &HistoryWidget::showPrDetailedView);
 
    mRepositoryView->setObjectName("historyGraphView");
@@ -305,6 +306,16 @@ void HistoryWidget::updateGraphView(int totalCommits)
        QItemSelectionModel::Select);
 }
 
+void HistoryWidget::appendGraphRows(int totalCommits)
+{
+   mRepositoryModel->onRevisionsAppended(totalCommits);
+}
+
+void HistoryWidget::insertGraphRows(const QVector<int> &rows)
+{
+   mRepositoryModel->onRevisionsInserted(rows);
+}
+
 void HistoryWidget::keyPressEvent(QKeyEvent *event)
 {
    if (event->key() == Qt::Key_Shift)
@@ -389,25 +400,53 @@ void HistoryWidget::search()
 
       if (commitInfo.isValid())
          goToSha(text);
-      else
+      else if (!mCommitTextsLoaded && mCache->hasMissingCommitTexts())
       {
-         auto selectedItems = mRepositoryView->selectedIndexes();
-         auto startingRow = 0;
-
-         if (!selectedItems.isEmpty())
+         // The rows loaded from the commit-graph have no message nor author yet. The search runs once the loader has
+         // all of them.
+         if (!mSearchPending)
          {
-            std::sort(selectedItems.begin(), selectedItems.end(),
-                      [](const QModelIndex index1, const QModelIndex index2) { return index1.row() <= index2.row(); });
-            startingRow = selectedItems.constFirst().row();
+            mSearchPending = true;
+
+            emit signalCommitTextsRequested();
          }
+      }
+      else
+         searchText(text);
+   }
+}
 
-         commitInfo = mCache->searchCommitInfo(text, startingRow + 1, mReverseSearch);
+void HistoryWidget::searchText(const QString &text)
+{
+   auto selectedItems = mRepositoryView->selectedIndexes();
+   auto startingRow = 0;
 
-         if (commitInfo.isValid())
-            goToSha(commitInfo.sha);
-         else
-            QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
-      }
+   if (!selectedItems.isEmpty())
+   {
+      std::sort(selectedItems.begin(), selectedItems.end(),
+                [](const QModelIndex index1, const QModelIndex index2) { return index1.row() <= index2.row(); });
+      startingRow = selectedItems.constFirst().row();
+   }
+
+   const auto commitInfo = mCache->searchCommitInfo(text, startingRow + 1, mReverseSearch);
+
+   if (commitInfo.isValid())
+      goToSha(commitInfo.sha);
+   else
+      QMessageBox::information(this, tr("Not found!"), tr("No commits where found based on the search text."));
+}
+
+void HistoryWidget::onCommitTextsLoaded()
+{
+   // The texts that couldn't be loaded are not requested again, the search looks at the ones that are available.
+   mCommitTextsLoaded = true;
+
+   if (mSearchPending)
+   {
+      mSearchPending = false;
+
+      if (const auto text = mSearchInput->text(); !text.isEmpty())
+         searchText(text);
    }
 }
 
@@ -117,6 +117,14 @@ signals:
     \param showAll True to show all the branches, false if only the current branch must be shown.
    */
    void signalAllBranchesActive(bool showAll);
+   /*!
+    \brief Signal triggered when the user scrolls close to the end of the loaded history.
+   */
+   void signalNextPageRequested();
+   /*!
+    \brief Signal triggered when a search needs the texts of the commits that were loaded without them.
+   */
+   void signalCommitTextsRequested();
    /*!
     \brief Signal triggered when the user performs a merge and it contains conflicts.
    */
@@ -205,6 +213,27 @@ public:
    */
    void updateGraphView(int totalCommits);
 
+   /*!
+    \brief Appends the new rows to the history model of the repository graph view while the history is still being
+    loaded. The current selection and scroll position are kept.
+
+    \param totalCommits The new total of commits to show in the graph.
+   */
+   void appendGraphRows(int totalCommits);
+
+   /*!
+    \brief Inserts the rows of the new revisions found by an incremental reload. The current selection and scroll
+    position are kept.
+
+    \param rows The positions of the new rows in the graph.
+   */
+   void insertGraphRows(const QVector<int> &rows);
+
+   /*!
+    \brief Runs the search that was waiting for the texts of the commits.
+   */
+   void onCommitTextsLoaded();
+
    /**
     * @brief onCommitTitleMaxLenghtChanged Changes the maximum length of the commit title.
     */
@@ -249,6 +278,8 @@ private:
    QLabel *mUserName = nullptr;
    QLabel *mUserEmail = nullptr;
    bool mReverseSearch = false;
+   bool mSearchPending = false;
+   bool mCommitTextsLoaded = false;
    QSplitter *mSplitter = nullptr;
 
    /*!
@@ -256,6 +287,12 @@ private:
 
    */
    void search();
+   /*!
+    \brief Searches the next commit whose message or author contains the text, starting after the selected one.
+
+    \param text The text to search.
+   */
+   void searchText(const QString &text);
    /*!
     \brief Goes to the selected SHA.
 
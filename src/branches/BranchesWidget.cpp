@@ -8,6 +8,7 @@
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitConfig.h>
+#include <GitFuture.h>
 #include <GitQlientBranchItemRole.h>
 #include <GitQlientSettings.h>
 #include <GitStashes.h>
@@ -844,13 +845,12 @@ void BranchesWidget::showTagsContextMenu(const QPoint &p)
       const auto pushTagAction = menu->addAction(tr("Push tag"));
       pushTagAction->setEnabled(!isRemote);
       connect(pushTagAction, &QAction::triggered, this, [this, tagName]() {
-         QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
          QScopedPointer<GitTags> git(new GitTags(mGit));
-         const auto ret = git->pushTag(tagName);
-         QApplication::restoreOverrideCursor();
 
-         if (ret.success)
-            mGitTags->getRemoteTags();
+         GitFuture::then(git->pushTagAsync(tagName), this, [this](const GitExecResult &ret) {
+            if (ret.success)
+               mGitTags->getRemoteTags();
+         });
       });
 
       menu->exec(mTagsTree->viewport()->mapToGlobal(p));
@@ -2,10 +2,15 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/CommitInfo.h \
+    $$PWD/CommitStore.h \
     $$PWD/GitCache.h \
     $$PWD/GitServerCache.h \
+    $$PWD/HistoryCacheFile.h \
+    $$PWD/Identity.h \
     $$PWD/Lane.h \
     $$PWD/LaneType.h \
+    $$PWD/ObjectId.h \
+    $$PWD/PathTable.h \
     $$PWD/References.h \
     $$PWD/RevisionFiles.h \
     $$PWD/WipRevisionInfo.h \
@@ -13,9 +18,12 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/CommitInfo.cpp \
+    $$PWD/CommitStore.cpp \
     $$PWD/GitCache.cpp \
     $$PWD/GitServerCache.cpp \
+    $$PWD/HistoryCacheFile.cpp \
     $$PWD/Lane.cpp \
+    $$PWD/PathTable.cpp \
     $$PWD/References.cpp \
     $$PWD/RevisionFiles.cpp \
     $$PWD/lanes.cpp
@@ -1,49 +1,111 @@
 #include "CommitInfo.h"
 
+#include <ObjectId.h>
+
 #include <QStringList>
 
+#include <cstring>
+
 const QString CommitInfo::ZERO_SHA = QString("0000000000000000000000000000000000000000");
 const QString CommitInfo::INIT_SHA = QString("4b825dc642cb6eb9a060e54bf8d69288fbee4904");
 
-CommitInfo::CommitInfo(QByteArray commitData, const QString &gpg, bool goodSignature)
+CommitInfo::CommitInfo(const char *commitData, int length, const QString &gpg, bool goodSignature)
    : gpgKey(gpg)
    , mGoodSignature(goodSignature)
 {
-   parseDiff(commitData, 0);
+   parseDiff(commitData, length, 0);
+}
+
+CommitInfo::CommitInfo(const char *commitData, int length)
+{
+   parseDiff(commitData, length, 1);
 }
 
-CommitInfo::CommitInfo(QByteArray data)
+void CommitInfo::parseDiff(const char *data, int length, int startingField)
 {
-    parseDiff(data, 1);
+   // The record is parsed in place: every field is located with memchr (vectorized by the C runtime) and only the
+   // fields that are stored get decoded to UTF-16.
+   auto cursor = data;
+   const auto end = data + length;
+
+   for (; startingField > 0 && cursor < end; --startingField)
+      takeLine(cursor, end);
+
+   if (cursor >= end)
+      return;
+
+   auto shaLine = takeLine(cursor, end);
+
+   if (shaLine.empty())
+      return;
+
+   // The first character is the boundary mark (%m).
+   shaLine.remove_prefix(1);
+
+   const auto separator = shaLine.find('X');
+   const auto shaView = shaLine.substr(0, separator);
+   sha = QString::fromLatin1(shaView.data(), static_cast<int>(shaView.size()));
+
+   if (separator != std::string_view::npos)
+   {
+      auto parents = shaLine.substr(separator + 1);
+
+      while (!parents.empty())
+      {
+         const auto space = parents.find(' ');
+         const auto parent = parents.substr(0, space);
+
+         if (!parent.empty())
+            mParentsSha.append(QString::fromLatin1(parent.data(), static_cast<int>(parent.size())));
+
+         if (space == std::string_view::npos)
+            break;
+
+         parents.remove_prefix(space + 1);
+      }
+   }
+
+   committer = Identity::fromUtf8(takeLine(cursor, end));
+   author = Identity::fromUtf8(takeLine(cursor, end));
+
+   qint64 seconds = 0;
+   for (const auto digit : takeLine(cursor, end))
+   {
+      if (digit >= '0' && digit <= '9')
+         seconds = seconds * 10 + (digit - '0');
+   }
+   dateSinceEpoch = std::chrono::seconds(seconds);
+
+   const auto shortLogLine = takeLine(cursor, end);
+   shortLog = QString::fromUtf8(shortLogLine.data(), static_cast<int>(shortLogLine.size()));
+
+   // The body is the rest of the record. It's trimmed without copying before decoding it.
+   auto bodyEnd = end;
+
+   while (cursor < bodyEnd && isSpace(*cursor))
+      ++cursor;
+
+   while (bodyEnd > cursor && isSpace(*(bodyEnd - 1)))
+      --bodyEnd;
+
+   if (cursor < bodyEnd)
+      longLog = QString::fromUtf8(cursor, static_cast<int>(bodyEnd - cursor));
 }
 
-void CommitInfo::parseDiff(QByteArray &data, int startingField)
+std::string_view CommitInfo::takeLine(const char *&cursor, const char *end)
 {
-    if (const auto fields = QString::fromUtf8(data).split('\n'); fields.count() > 0)
-    {
-       const auto firstField = fields.constFirst();
-       auto combinedShas = fields.at(startingField++);
-       auto shas = combinedShas.split('X');
-       sha = shas.takeFirst().remove(0, 1);
+   const auto lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+   const auto stop = lineEnd ? lineEnd : end;
+   const std::string_view line(cursor, static_cast<size_t>(stop - cursor));
 
-       if (!shas.isEmpty())
-       {
- #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-          mParentsSha = shas.takeFirst().split(' ', Qt::SkipEmptyParts);
- #else
-          mParentsSha = shas.takeFirst().split(' ', QString::SkipEmptyParts);
- #endif
-       }
-       committer = fields.at(startingField++);
-       author = fields.at(startingField++);
-       dateSinceEpoch = std::chrono::seconds(fields.at(startingField++).toInt());
-       shortLog = fields.at(startingField);
+   cursor = lineEnd ? lineEnd + 1 : end;
 
-       for (auto i = 6; i < fields.count(); ++i)
-          longLog += fields.at(i) + '\n';
+   return line;
+}
 
-       longLog = longLog.trimmed();
-    }
+bool CommitInfo::isSpace(char c)
+{
+   return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
 CommitInfo::CommitInfo(const QString &sha, const QStringList &parents, std::chrono::seconds commitDate,
@@ -70,7 +132,8 @@ bool CommitInfo::operator!=(const CommitInfo &commit) const
 bool CommitInfo::contains(const QString &value)
 {
    return sha.startsWith(value, Qt::CaseInsensitive) || shortLog.contains(value, Qt::CaseInsensitive)
-       || committer.contains(value, Qt::CaseInsensitive) || author.contains(value, Qt::CaseInsensitive);
+       || committer.toString().contains(value, Qt::CaseInsensitive)
+       || author.toString().contains(value, Qt::CaseInsensitive);
 }
 
 int CommitInfo::parentsCount() const
@@ -95,16 +158,7 @@ QStringList CommitInfo::parents() const
 
 bool CommitInfo::isInWorkingBranch() const
 {
-   for (const auto &child : mChilds)
-   {
-      if (child->sha == CommitInfo::ZERO_SHA)
-      {
-         return true;
-         break;
-      }
-   }
-
-   return false;
+   return mChilds.contains(CommitInfo::ZERO_SHA);
 }
 
 void CommitInfo::setLanes(QVector<Lane> lanes)
@@ -116,9 +170,7 @@ void CommitInfo::setLanes(QVector<Lane> lanes)
 
 bool CommitInfo::isValid() const
 {
-   static QRegExp hexMatcher("^[0-9A-F]{40}$", Qt::CaseInsensitive);
-
-   return !sha.isEmpty() && hexMatcher.exactMatch(sha);
+   return ObjectId::fromString(sha).isValid();
 }
 
 int CommitInfo::getActiveLane() const
@@ -136,15 +188,7 @@ int CommitInfo::getActiveLane() const
    return -1;
 }
 
-void CommitInfo::removeChild(CommitInfo *commit)
-{
-   if (mChilds.contains(commit))
-      mChilds.removeAll(commit);
-}
-
 QString CommitInfo::getFirstChildSha() const
 {
-   if (!mChilds.isEmpty())
-      mChilds.constFirst();
-   return QString();
+   return mChilds.isEmpty() ? QString() : mChilds.constFirst();
 }
@@ -28,7 +28,9 @@
 #include <QVector>
 
 #include <chrono>
+#include <string_view>
 
+#include <Identity.h>
 #include <Lane.h>
 #include <References.h>
 
@@ -48,8 +50,8 @@ public:
 
    CommitInfo() = default;
    ~CommitInfo() = default;
-   CommitInfo(QByteArray commitData);
-   CommitInfo(QByteArray commitData, const QString &gpg, bool goodSignature);
+   CommitInfo(const char *commitData, int length);
+   CommitInfo(const char *commitData, int length, const QString &gpg, bool goodSignature);
    explicit CommitInfo(const QString &sha, const QStringList &parents, std::chrono::seconds commitDate,
                        const QString &log);
    bool operator==(const CommitInfo &commit) const;
@@ -69,8 +71,8 @@ public:
    Lane laneAt(int i) const { return mLanes.at(i); }
    int getActiveLane() const;
 
-   void appendChild(CommitInfo *commit) { mChilds.append(commit); }
-   void removeChild(CommitInfo *commit);
+   void appendChild(const QString &sha) { mChilds.append(sha); }
+   void removeChild(const QString &sha) { mChilds.removeAll(sha); }
    bool hasChilds() const { return !mChilds.empty(); }
    QString getFirstChildSha() const;
    int getChildsCount() const { return mChilds.count(); }
@@ -83,8 +85,8 @@ public:
 
    uint pos = 0;
    QString sha;
-   QString committer;
-   QString author;
+   Identity committer;
+   Identity author;
    std::chrono::seconds dateSinceEpoch;
    QString shortLog;
    QString longLog;
@@ -94,9 +96,12 @@ private:
    bool mGoodSignature = false;
    QVector<Lane> mLanes;
    QStringList mParentsSha;
-   QVector<CommitInfo *> mChilds;
+   QStringList mChilds;
 
+   friend class CommitStore;
    friend class GitCache;
 
-   void parseDiff(QByteArray &data, int startingField);
+   void parseDiff(const char *data, int length, int startingField);
+   static std::string_view takeLine(const char *&cursor, const char *end);
+   static bool isSpace(char c);
 };
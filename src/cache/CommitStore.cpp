@@ -0,0 +1,654 @@
+#include "CommitStore.h"
+
+namespace
+{
+char toLowerAscii(char c)
+{
+   return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+}
+
+void CommitStore::clear()
+{
+   mShas.clear();
+   mShas.squeeze();
+   mIndex.clear();
+   mIndex.squeeze();
+   mFlags.clear();
+   mFlags.squeeze();
+   mDates.clear();
+   mDates.squeeze();
+   mPositions.clear();
+   mPositions.squeeze();
+   mCommitters.clear();
+   mCommitters.squeeze();
+   mAuthors.clear();
+   mAuthors.squeeze();
+   mShortLogs.clear();
+   mShortLogs.squeeze();
+   mLongLogs.clear();
+   mLongLogs.squeeze();
+   mGpgKeys.clear();
+   mGpgKeys.squeeze();
+   mParentRanges.clear();
+   mParentRanges.squeeze();
+   mParents.clear();
+   mParents.squeeze();
+   mChildRanges.clear();
+   mChildRanges.squeeze();
+   mChildren.clear();
+   mChildren.squeeze();
+   mPendingChildren.clear();
+   mPendingChildren.squeeze();
+   mLaneRows.clear();
+   mLaneRows.squeeze();
+   mLaneTable.clear();
+   mLaneTable.squeeze();
+   mLaneTableIds.clear();
+   mLaneTableIds.squeeze();
+   mText.clear();
+   mText.squeeze();
+   mIdentities.clear();
+   mIdentities.squeeze();
+   mIdentityIds.clear();
+   mIdentityIds.squeeze();
+   mNeedleText.clear();
+   mNeedleIdentities.clear();
+   mWastedParents = 0;
+   mWastedChildren = 0;
+   mWastedText = 0;
+}
+
+void CommitStore::reserve(int commits)
+{
+   mShas.reserve(commits);
+   mIndex.reserve(commits);
+   mFlags.reserve(commits);
+   mDates.reserve(commits);
+   mPositions.reserve(commits);
+   mCommitters.reserve(commits);
+   mAuthors.reserve(commits);
+   mShortLogs.reserve(commits);
+   mLongLogs.reserve(commits);
+   mGpgKeys.reserve(commits);
+   mParentRanges.reserve(commits);
+   mParents.reserve(commits);
+   mChildRanges.reserve(commits);
+   mChildren.reserve(commits);
+   mLaneRows.reserve(commits);
+}
+
+void CommitStore::squeeze()
+{
+   mShas.squeeze();
+   mIndex.squeeze();
+   mFlags.squeeze();
+   mDates.squeeze();
+   mPositions.squeeze();
+   mCommitters.squeeze();
+   mAuthors.squeeze();
+   mShortLogs.squeeze();
+   mLongLogs.squeeze();
+   mGpgKeys.squeeze();
+   mParentRanges.squeeze();
+   mParents.squeeze();
+   mChildRanges.squeeze();
+   mChildren.squeeze();
+   mLaneRows.squeeze();
+   mLaneTable.squeeze();
+   mText.squeeze();
+}
+
+int CommitStore::idOf(const ObjectId &sha) const
+{
+   return sha.isValid() ? mIndex.value(sha, INVALID_ID) : INVALID_ID;
+}
+
+int CommitStore::idOfPrefix(const QString &shaPrefix) const
+{
+   if (shaPrefix.isEmpty())
+      return INVALID_ID;
+
+   const auto total = mShas.count();
+
+   for (auto id = 0; id < total; ++id)
+   {
+      if ((mFlags.at(id) & HasData) && mShas.at(id).startsWith(shaPrefix))
+         return id;
+   }
+
+   return INVALID_ID;
+}
+
+bool CommitStore::hasData(int id) const
+{
+   return id >= 0 && id < mFlags.count() && (mFlags.at(id) & HasData);
+}
+
+int CommitStore::insert(const CommitInfo &commit)
+{
+   const auto id = findOrAddId(ObjectId::fromString(commit.sha));
+
+   if (id == INVALID_ID)
+      return INVALID_ID;
+
+   const auto oldParents = mParentRanges.at(id);
+
+   // When the data is replaced, the commit is no longer a child of its previous parents.
+   if (mFlags.at(id) & HasData)
+   {
+      for (auto i = 0U; i < oldParents.count; ++i)
+         removeChild(mParents.at(static_cast<int>(oldParents.start + i)), id);
+   }
+   else
+      mChildRanges[id] = Range();
+
+   mFlags[id] = HasData | (commit.mGoodSignature ? GoodSignature : 0);
+   mDates[id] = commit.dateSinceEpoch.count();
+   mPositions[id] = static_cast<int>(commit.pos);
+   mCommitters[id] = addIdentity(commit.committer);
+   mAuthors[id] = addIdentity(commit.author);
+   mShortLogs[id] = replaceText(mShortLogs.at(id), commit.shortLog);
+   mLongLogs[id] = replaceText(mLongLogs.at(id), commit.longLog);
+   mGpgKeys[id] = replaceText(mGpgKeys.at(id), commit.gpgKey);
+   mLaneRows[id] = addLaneRow(commit.mLanes);
+
+   QVector<int> parentIds;
+   parentIds.reserve(commit.mParentsSha.count());
+
+   for (const auto &parent : commit.mParentsSha)
+   {
+      if (const auto parentId = findOrAddId(ObjectId::fromString(parent)); parentId != INVALID_ID)
+         parentIds.append(parentId);
+   }
+
+   // A replaced commit, like the WIP, usually keeps the number of parents, so its range is overwritten.
+   Range parentRange { oldParents.start, static_cast<quint32>(parentIds.count()) };
+
+   if (parentRange.count == oldParents.count)
+   {
+      for (auto i = 0U; i < parentRange.count; ++i)
+         mParents[static_cast<int>(parentRange.start + i)] = parentIds.at(static_cast<int>(i));
+   }
+   else
+   {
+      mWastedParents += oldParents.count;
+      parentRange.start = static_cast<quint32>(mParents.count());
+      mParents.append(parentIds);
+   }
+
+   mParentRanges[id] = parentRange;
+
+   for (const auto parentId : qAsConst(parentIds))
+   {
+      if (hasData(parentId))
+         appendChild(parentId, id);
+      else
+         mPendingChildren[parentId].append(id);
+   }
+
+   // The log always lists the children before their parents, so they are all known at this point.
+   if (const auto iter = mPendingChildren.find(id); iter != mPendingChildren.end())
+   {
+      mChildRanges[id] = { static_cast<quint32>(mChildren.count()), static_cast<quint32>(iter.value().count()) };
+      mChildren.append(iter.value());
+      mPendingChildren.erase(iter);
+   }
+
+   compactIfWasted();
+
+   return id;
+}
+
+void CommitStore::setText(int id, const CommitInfo &commit)
+{
+   if (!hasData(id))
+      return;
+
+   mFlags[id] = HasData | (commit.mGoodSignature ? GoodSignature : 0);
+   mDates[id] = commit.dateSinceEpoch.count();
+   mCommitters[id] = addIdentity(commit.committer);
+   mAuthors[id] = addIdentity(commit.author);
+   mShortLogs[id] = replaceText(mShortLogs.at(id), commit.shortLog);
+   mLongLogs[id] = replaceText(mLongLogs.at(id), commit.longLog);
+   mGpgKeys[id] = replaceText(mGpgKeys.at(id), commit.gpgKey);
+
+   compactIfWasted();
+}
+
+void CommitStore::remove(int id)
+{
+   if (!hasData(id))
+      return;
+
+   const auto range = mParentRanges.at(id);
+
+   for (auto i = 0U; i < range.count; ++i)
+      removeChild(mParents.at(static_cast<int>(range.start + i)), id);
+
+   mWastedParents += range.count;
+   mWastedChildren += mChildRanges.at(id).count;
+   mWastedText += mShortLogs.at(id).size + mLongLogs.at(id).size + mGpgKeys.at(id).size;
+
+   mIndex.remove(mShas.at(id));
+   mFlags[id] = 0;
+   mPositions[id] = -1;
+   mShortLogs[id] = TextRef();
+   mLongLogs[id] = TextRef();
+   mGpgKeys[id] = TextRef();
+   mParentRanges[id] = Range();
+   mChildRanges[id] = Range();
+   mLaneRows[id] = 0;
+
+   compactIfWasted();
+}
+
+CommitInfo CommitStore::commit(int id) const
+{
+   if (!hasData(id))
+      return CommitInfo();
+
+   QStringList parents;
+   const auto parentRange = mParentRanges.at(id);
+   parents.reserve(static_cast<int>(parentRange.count));
+
+   for (auto i = 0U; i < parentRange.count; ++i)
+      parents.append(mShas.at(mParents.at(static_cast<int>(parentRange.start + i))).toString());
+
+   CommitInfo commit(mShas.at(id).toString(), parents, std::chrono::seconds(mDates.at(id)), text(mShortLogs.at(id)));
+   commit.pos = static_cast<uint>(mPositions.at(id));
+   commit.committer = mIdentities.value(mCommitters.at(id));
+   commit.author = mIdentities.value(mAuthors.at(id));
+   commit.longLog = text(mLongLogs.at(id));
+   commit.gpgKey = text(mGpgKeys.at(id));
+   commit.mGoodSignature = mFlags.at(id) & GoodSignature;
+   commit.mLanes = lanes(id);
+
+   const auto childRange = mChildRanges.at(id);
+   commit.mChilds.reserve(static_cast<int>(childRange.count));
+
+   for (auto i = 0U; i < childRange.count; ++i)
+      commit.mChilds.append(mShas.at(mChildren.at(static_cast<int>(childRange.start + i))).toString());
+
+   return commit;
+}
+
+bool CommitStore::contains(int id, const QString &text) const
+{
+   if (!hasData(id))
+      return false;
+
+   prepareNeedle(text);
+
+   return mShas.at(id).startsWith(text) || textContains(mShortLogs.at(id)) || identityContains(mCommitters.at(id))
+       || identityContains(mAuthors.at(id));
+}
+
+QString CommitStore::sha(int id) const
+{
+   return id >= 0 && id < mShas.count() ? mShas.at(id).toString() : QString();
+}
+
+QVector<Lane> CommitStore::lanes(int id) const
+{
+   const auto row = mLaneRows.at(id);
+
+   return row == 0 ? QVector<Lane>() : mLaneTable.at(static_cast<int>(row - 1));
+}
+
+int CommitStore::firstParent(int id) const
+{
+   if (!hasData(id))
+      return INVALID_ID;
+
+   const auto range = mParentRanges.at(id);
+
+   return range.count > 0 ? mParents.at(static_cast<int>(range.start)) : INVALID_ID;
+}
+
+QVector<int> CommitStore::parents(int id) const
+{
+   if (!hasData(id))
+      return QVector<int>();
+
+   const auto range = mParentRanges.at(id);
+
+   return mParents.mid(static_cast<int>(range.start), static_cast<int>(range.count));
+}
+
+QVector<int> CommitStore::children(int id) const
+{
+   if (!hasData(id))
+      return QVector<int>();
+
+   const auto range = mChildRanges.at(id);
+
+   return mChildren.mid(static_cast<int>(range.start), static_cast<int>(range.count));
+}
+
+void CommitStore::appendChild(int id, int child)
+{
+   if (child == INVALID_ID || id < 0 || id >= mShas.count())
+      return;
+
+   if (!hasData(id))
+   {
+      if (auto &pending = mPendingChildren[id]; !pending.contains(child))
+         pending.append(child);
+
+      return;
+   }
+
+   auto range = mChildRanges.at(id);
+
+   for (auto i = 0U; i < range.count; ++i)
+   {
+      if (mChildren.at(static_cast<int>(range.start + i)) == child)
+         return;
+   }
+
+   // The ranges can't grow in place unless they are at the end of the array, so the range is moved there first.
+   if (range.start + range.count != static_cast<quint32>(mChildren.count()))
+   {
+      const auto start = static_cast<quint32>(mChildren.count());
+
+      for (auto i = 0U; i < range.count; ++i)
+      {
+         const auto value = mChildren.at(static_cast<int>(range.start + i));
+         mChildren.append(value);
+      }
+
+      mWastedChildren += range.count;
+      range.start = start;
+   }
+
+   mChildren.append(child);
+   ++range.count;
+
+   mChildRanges[id] = range;
+}
+
+void CommitStore::removeChild(int id, int child)
+{
+   if (!hasData(id))
+   {
+      if (const auto iter = mPendingChildren.find(id); iter != mPendingChildren.end())
+         iter.value().removeAll(child);
+
+      return;
+   }
+
+   auto range = mChildRanges.at(id);
+
+   for (auto i = 0U; i < range.count; ++i)
+   {
+      if (mChildren.at(static_cast<int>(range.start + i)) == child)
+      {
+         for (auto j = i + 1; j < range.count; ++j)
+            mChildren[static_cast<int>(range.start + j - 1)] = mChildren.at(static_cast<int>(range.start + j));
+
+         --range.count;
+         mChildRanges[id] = range;
+         ++mWastedChildren;
+
+         return;
+      }
+   }
+}
+
+bool CommitStore::rebuildIndexes()
+{
+   const auto total = mShas.count();
+   const auto identities = mIdentities.count();
+
+   mIndex.clear();
+   mIndex.reserve(total);
+   mIdentityIds.clear();
+   mIdentityIds.reserve(identities);
+   mLaneTableIds.clear();
+   mLaneTableIds.reserve(mLaneTable.count());
+   mPendingChildren.clear();
+
+   // When a SHA has more than one id, the last one is the current: the older ones were removed.
+   for (auto id = 0; id < total; ++id)
+   {
+      if (!mShas.at(id).isValid() || mCommitters.at(id) >= identities || mAuthors.at(id) >= identities)
+         return false;
+
+      mIndex.insert(mShas.at(id), id);
+   }
+
+   for (auto i = 0; i < identities; ++i)
+      mIdentityIds.insert(mIdentities.at(i), i);
+
+   for (auto i = 0; i < mLaneTable.count(); ++i)
+      mLaneTableIds.insert(mLaneTable.at(i), static_cast<quint32>(i + 1));
+
+   const auto laneRows = static_cast<quint32>(mLaneTable.count());
+
+   if (mLaneRows.count() != total
+       || std::any_of(mLaneRows.cbegin(), mLaneRows.cend(), [laneRows](quint32 row) { return row > laneRows; }))
+   {
+      return false;
+   }
+
+   const auto validRanges = [](const QVector<Range> &ranges, int size) {
+      return std::all_of(ranges.cbegin(), ranges.cend(), [size](const Range &range) {
+         return static_cast<quint64>(range.start) + range.count <= static_cast<quint64>(size);
+      });
+   };
+   const auto validIds = [total](const QVector<int> &ids) {
+      return std::all_of(ids.cbegin(), ids.cend(), [total](int id) { return id >= 0 && id < total; });
+   };
+   const auto validTexts = [size = mText.size()](const QVector<TextRef> &refs) {
+      return std::all_of(refs.cbegin(), refs.cend(), [size](const TextRef &ref) {
+         return static_cast<quint64>(ref.offset) + ref.size <= static_cast<quint64>(size);
+      });
+   };
+
+   return validRanges(mParentRanges, mParents.count()) && validRanges(mChildRanges, mChildren.count())
+       && validIds(mParents) && validIds(mChildren) && validTexts(mShortLogs) && validTexts(mLongLogs)
+       && validTexts(mGpgKeys);
+}
+
+int CommitStore::findOrAddId(const ObjectId &sha)
+{
+   if (!sha.isValid())
+      return INVALID_ID;
+
+   if (const auto iter = mIndex.constFind(sha); iter != mIndex.constEnd())
+      return iter.value();
+
+   const auto id = mShas.count();
+
+   mShas.append(sha);
+   mIndex.insert(sha, id);
+   mFlags.append(0);
+   mDates.append(0);
+   mPositions.append(-1);
+   mCommitters.append(INVALID_ID);
+   mAuthors.append(INVALID_ID);
+   mShortLogs.append(TextRef());
+   mLongLogs.append(TextRef());
+   mGpgKeys.append(TextRef());
+   mParentRanges.append(Range());
+   mChildRanges.append(Range());
+   mLaneRows.append(0);
+
+   return id;
+}
+
+CommitStore::TextRef CommitStore::replaceText(const TextRef &current, const QString &text)
+{
+   const auto utf8 = text.toUtf8();
+   const auto size = static_cast<quint32>(utf8.size());
+
+   // The slot of the previous text is reused when the new one fits in it.
+   if (size <= current.size)
+   {
+      mWastedText += current.size - size;
+
+      if (size == 0)
+         return TextRef();
+
+      std::copy(utf8.cbegin(), utf8.cend(), mText.begin() + current.offset);
+
+      return { current.offset, size };
+   }
+
+   mWastedText += current.size;
+
+   const TextRef ref { static_cast<quint32>(mText.size()), size };
+
+   mText.append(utf8);
+
+   return ref;
+}
+
+void CommitStore::compactIfWasted()
+{
+   // The replaced ranges and texts stay behind in the arrays. They are dropped once they are half of them.
+   const auto tooMuch = [](qint64 wasted, qint64 size) { return wasted > 4096 && wasted * 2 > size; };
+
+   if (tooMuch(mWastedParents, mParents.count()) || tooMuch(mWastedChildren, mChildren.count())
+       || tooMuch(mWastedText, mText.size()))
+   {
+      compact();
+   }
+}
+
+void CommitStore::compact()
+{
+   QVector<int> parents;
+   QVector<int> children;
+   QByteArray text;
+
+   parents.reserve(mParents.count() - mWastedParents);
+   children.reserve(mChildren.count() - mWastedChildren);
+   text.reserve(static_cast<int>(mText.size() - mWastedText));
+
+   const auto moveRange = [](Range &range, const QVector<int> &from, QVector<int> &to) {
+      const auto start = static_cast<quint32>(to.count());
+
+      for (auto i = 0U; i < range.count; ++i)
+         to.append(from.at(static_cast<int>(range.start + i)));
+
+      range.start = start;
+   };
+   const auto moveText = [this, &text](TextRef &ref) {
+      if (ref.size > 0)
+      {
+         const auto offset = static_cast<quint32>(text.size());
+         text.append(mText.constData() + ref.offset, static_cast<int>(ref.size));
+         ref.offset = offset;
+      }
+   };
+
+   for (auto id = 0; id < mShas.count(); ++id)
+   {
+      moveRange(mParentRanges[id], mParents, parents);
+      moveRange(mChildRanges[id], mChildren, children);
+      moveText(mShortLogs[id]);
+      moveText(mLongLogs[id]);
+      moveText(mGpgKeys[id]);
+   }
+
+   mParents = parents;
+   mChildren = children;
+   mText = text;
+   mWastedParents = 0;
+   mWastedChildren = 0;
+   mWastedText = 0;
+}
+
+QString CommitStore::text(const TextRef &ref) const
+{
+   return ref.size > 0 ? QString::fromUtf8(mText.constData() + ref.offset, static_cast<int>(ref.size)) : QString();
+}
+
+int CommitStore::addIdentity(const Identity &identity)
+{
+   if (const auto iter = mIdentityIds.constFind(identity); iter != mIdentityIds.constEnd())
+      return iter.value();
+
+   const auto index = mIdentities.count();
+
+   mIdentities.append(identity);
+   mIdentityIds.insert(identity, index);
+
+   return index;
+}
+
+quint32 CommitStore::addLaneRow(const QVector<Lane> &lanes)
+{
+   if (lanes.isEmpty())
+      return 0;
+
+   if (const auto iter = mLaneTableIds.constFind(lanes); iter != mLaneTableIds.constEnd())
+      return iter.value();
+
+   mLaneTable.append(lanes);
+
+   const auto row = static_cast<quint32>(mLaneTable.count());
+
+   // The key shares the data of the table entry.
+   mLaneTableIds.insert(mLaneTable.constLast(), row);
+
+   return row;
+}
+
+void CommitStore::prepareNeedle(const QString &text) const
+{
+   if (text == mNeedleText && !mNeedleText.isNull())
+      return;
+
+   mNeedleText = text.isNull() ? QString::fromLatin1("") : text;
+   mNeedleIsAscii = std::all_of(text.cbegin(), text.cend(), [](QChar c) { return c.unicode() < 0x80; });
+   mNeedle = mNeedleIsAscii ? text.toLatin1().toLower() : QByteArray();
+   mNeedleIdentities.clear();
+}
+
+bool CommitStore::identityContains(int identity) const
+{
+   if (identity < 0 || identity >= mIdentities.count())
+      return false;
+
+   // There are far less identities than commits, so every identity is matched only once per search text.
+   for (auto i = mNeedleIdentities.count(); i <= identity; ++i)
+      mNeedleIdentities.append(mIdentities.at(i).toString().contains(mNeedleText, Qt::CaseInsensitive));
+
+   return mNeedleIdentities.at(identity);
+}
+
+bool CommitStore::textContains(const TextRef &ref) const
+{
+   // Non-ASCII searches need the case folding of QString. ASCII ones are done on the UTF-8 bytes: a multi-byte
+   // sequence never contains ASCII bytes.
+   if (!mNeedleIsAscii)
+      return text(ref).contains(mNeedleText, Qt::CaseInsensitive);
+
+   const auto needleSize = static_cast<quint32>(mNeedle.size());
+
+   if (needleSize == 0)
+      return true;
+
+   if (ref.size < needleSize)
+      return false;
+
+   const auto haystack = mText.constData() + ref.offset;
+   const auto needle = mNeedle.constData();
+   const auto last = ref.size - needleSize;
+
+   for (auto i = 0U; i <= last; ++i)
+   {
+      auto j = 0U;
+
+      while (j < needleSize && toLowerAscii(haystack[i + j]) == needle[j])
+         ++j;
+
+      if (j == needleSize)
+         return true;
+   }
+
+   return false;
+}
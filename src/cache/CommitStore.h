@@ -0,0 +1,151 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+#include <ObjectId.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include <algorithm>
+
+/**
+ * @brief The CommitStore class keeps the commits of the cache in a columnar layout. Every commit is identified by an
+ * integer id and every field is stored in its own array indexed by that id. The SHAs are kept as ObjectId, the
+ * parents and children are kept as ranges of ids in two adjacency arrays and all the texts live in a single UTF-8
+ * arena. Authors and committers are indices in a table of identities, since a few of them cover most of the commits.
+ * The same happens with the lanes: most of the rows of the graph repeat the same lanes, so every distinct row is stored
+ * once and every commit keeps the index of its row.
+ *
+ * An id is assigned the first time a SHA is seen, either as a commit or as the parent of another commit. Until the
+ * data of a commit is inserted, its id is only a placeholder.
+ *
+ * The store is not thread-safe: the GitCache protects it.
+ */
+class CommitStore
+{
+public:
+   static const int INVALID_ID = -1;
+
+   void clear();
+   void reserve(int commits);
+   void squeeze();
+
+   int count() const { return mShas.count(); }
+   int idOf(const ObjectId &sha) const;
+   int idOf(const QString &sha) const { return idOf(ObjectId::fromString(sha)); }
+   int idOfPrefix(const QString &shaPrefix) const;
+   bool hasData(int id) const;
+
+   int insert(const CommitInfo &commit);
+   void remove(int id);
+   CommitInfo commit(int id) const;
+   bool contains(int id, const QString &text) const;
+
+   QString sha(int id) const;
+   bool hasLongLog(int id) const { return mLongLogs.at(id).size > 0; }
+   bool hasText(int id) const { return hasData(id) && !(mFlags.at(id) & MissingText); }
+   void setMissingText(int id) { mFlags[id] |= MissingText; }
+   void setText(int id, const CommitInfo &commit);
+   ObjectId objectId(int id) const { return mShas.at(id); }
+   qint64 date(int id) const { return mDates.at(id); }
+   int position(int id) const { return mPositions.at(id); }
+   void setPosition(int id, int position) { mPositions[id] = position; }
+   QVector<Lane> lanes(int id) const;
+   void setLanes(int id, const QVector<Lane> &lanes) { mLaneRows[id] = addLaneRow(lanes); }
+
+   int firstParent(int id) const;
+   QVector<int> parents(int id) const;
+   QVector<int> children(int id) const;
+   void appendChild(int id, int child);
+   void removeChild(int id, int child);
+
+private:
+   friend class HistoryCacheFile;
+
+   struct TextRef
+   {
+      quint32 offset = 0;
+      quint32 size = 0;
+   };
+
+   struct Range
+   {
+      quint32 start = 0;
+      quint32 count = 0;
+   };
+
+   enum Flag : quint8
+   {
+      HasData = 0x1,
+      GoodSignature = 0x2,
+      // Only the topology is known, the message and the identities are loaded later.
+      MissingText = 0x4,
+   };
+
+   QVector<ObjectId> mShas;
+   QHash<ObjectId, int> mIndex;
+   QVector<quint8> mFlags;
+   QVector<qint64> mDates;
+   QVector<int> mPositions;
+   QVector<int> mCommitters;
+   QVector<int> mAuthors;
+   QVector<TextRef> mShortLogs;
+   QVector<TextRef> mLongLogs;
+   QVector<TextRef> mGpgKeys;
+   QVector<Range> mParentRanges;
+   QVector<int> mParents;
+   QVector<Range> mChildRanges;
+   QVector<int> mChildren;
+   QHash<int, QVector<int>> mPendingChildren;
+   // Index in mLaneTable plus one, 0 is a row without lanes.
+   QVector<quint32> mLaneRows;
+   QVector<QVector<Lane>> mLaneTable;
+   QHash<QVector<Lane>, quint32> mLaneTableIds;
+   QByteArray mText;
+   QVector<Identity> mIdentities;
+   QHash<Identity, int> mIdentityIds;
+   mutable QString mNeedleText;
+   mutable QByteArray mNeedle;
+   mutable bool mNeedleIsAscii = true;
+   mutable QVector<bool> mNeedleIdentities;
+   // Entries of mParents, mChildren and mText that nothing points to any more.
+   int mWastedParents = 0;
+   int mWastedChildren = 0;
+   qint64 mWastedText = 0;
+
+   int findOrAddId(const ObjectId &sha);
+   bool rebuildIndexes();
+   TextRef replaceText(const TextRef &current, const QString &text);
+   void compactIfWasted();
+   void compact();
+   int addIdentity(const Identity &identity);
+   quint32 addLaneRow(const QVector<Lane> &lanes);
+   void prepareNeedle(const QString &text) const;
+   bool identityContains(int identity) const;
+   QString text(const TextRef &ref) const;
+   bool textContains(const TextRef &ref) const;
+};
@@ -1,15 +1,74 @@
 #include "GitCache.h"
 
 #include <QLogger.h>
+#include <Tracer.h>
 #include <WipRevisionInfo.h>
 
+#include <QTimer>
+
+#include <algorithm>
+
 using namespace QLogger;
 
+// Maximum number of characters of the commit bodies kept when they are loaded on demand.
+static const int BODIES_CACHE_SIZE = 4 * 1024 * 1024;
+// Rows between two snapshots of the lanes engine.
+static const int LANES_CHECKPOINT_INTERVAL = 1024;
+// Rows computed ahead of the one the view asks for.
+static const int LANES_LOOKAHEAD = 256;
+// Rows computed in the background each time the loader thread is idle.
+static const int LANES_FILL_BATCH = 4096;
+// Rows past the computed ones that the view computes itself. Further rows wait for the background fill.
+static const int LANES_PAINT_LIMIT = 1024;
+
+namespace
+{
+/**
+ * @brief Moves the lanes engine one revision forward and returns the lanes to draw for that revision. The revision and
+ * its parents are identified by their ids in the commit store.
+ */
+QVector<Lane> nextLanes(Lanes &lanes, int id, const QVector<int> &parents, int initId)
+{
+   auto parentsCount = parents.count();
+
+   if (parentsCount > 0 && initId != CommitStore::INVALID_ID && parents.contains(initId))
+      --parentsCount;
+
+   bool isDiscontinuity;
+   const auto isFork = lanes.isFork(id, isDiscontinuity);
+   const auto isMerge = parentsCount > 1;
+
+   if (isDiscontinuity)
+      lanes.changeActiveLane(id);
+
+   if (isFork)
+      lanes.setFork(id);
+   if (isMerge)
+      lanes.setMerge(parents);
+   if (parentsCount == 0)
+      lanes.setInitial();
+
+   const auto currentLanes = lanes.getLanes();
+
+   lanes.nextParent(parentsCount == 0 ? CommitStore::INVALID_ID : parents.constFirst());
+
+   if (isMerge)
+      lanes.afterMerge();
+   if (isFork)
+      lanes.afterFork();
+   if (lanes.isBranch())
+      lanes.afterBranch();
+
+   return currentLanes;
+}
+}
+
 GitCache::GitCache(QObject *parent)
    : QObject(parent)
    , mCommitsMutex(QMutex::Recursive)
    , mRevisionsMutex(QMutex::Recursive)
    , mReferencesMutex(QMutex::Recursive)
+   , mBodies(BODIES_CACHE_SIZE)
 {
 }
 
@@ -19,118 +78,185 @@ GitCache::~GitCache()
 }
 
 void GitCache::setup(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits)
+{
+   TRACE_SPAN("Cache", "Set up");
+
+   QMutexLocker lock(&mCommitsMutex);
+
+   beginSetup(wipInfo, commits.count());
+   appendCommits(std::move(commits));
+   finishSetup();
+}
+
+void GitCache::setupTopology(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits)
+{
+   TRACE_SPAN("Cache", "Set up topology");
+
+   QMutexLocker lock(&mCommitsMutex);
+
+   beginSetup(wipInfo, commits.count());
+   appendCommits(std::move(commits));
+
+   for (auto row = 1; row < mRows.count(); ++row)
+      mCommitsStore.setMissingText(mRows.at(row));
+
+   finishSetup();
+}
+
+void GitCache::beginSetup(const WipRevisionInfo &wipInfo, int expectedCommits)
 {
    QMutexLocker lock(&mCommitsMutex);
 
    mInitialized = true;
 
-   const auto totalCommits = commits.count() + 1;
+   const auto totalCommits = expectedCommits + 1;
 
    QLog_Debug("Cache", QString("Configuring the cache for {%1} elements.").arg(totalCommits));
 
    mConfigured = false;
 
-   mCommits.clear();
-   mCommits.squeeze();
-   mCommitsMap.clear();
-   mCommitsMap.squeeze();
-   mUntrackedFiles.clear();
-   mUntrackedFiles.squeeze();
+   mCommitsStore.clear();
+   mRows.clear();
+   mRows.squeeze();
    mLanes.clear();
+   mLaneCheckpoints.clear();
+   mLanesRow = 0;
 
-   mCommitsMap.reserve(totalCommits);
-   mCommits.resize(totalCommits);
+   mCommitsStore.reserve(totalCommits);
+   mRows.reserve(totalCommits);
+   mRows.append(CommitStore::INVALID_ID);
 
    QLog_Debug("Cache", QString("Adding WIP revision."));
 
    insertWipRevision(wipInfo);
+}
 
-   QLog_Debug("Cache", QString("Adding committed revisions."));
+int GitCache::appendCommits(QVector<CommitInfo> commits)
+{
+   // Inserting a commit also links it as a child of its parents.
+   TRACE_SPAN("Cache", "Insert commits");
 
-   QHash<QString, QVector<CommitInfo *>> tmpChildsStorage;
-   auto count = 0;
+   QMutexLocker lock(&mCommitsMutex);
+
+   QLog_Debug("Cache", QString("Adding {%1} committed revisions.").arg(commits.count()));
 
    for (auto &commit : commits)
    {
-      calculateLanes(commit);
-
-      const auto sha = commit.sha;
+      commit.pos = mRows.count();
 
-      if (sha == mCommitsMap.value(CommitInfo::ZERO_SHA).firstParent())
-         commit.appendChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
+      mRows.append(mCommitsStore.insert(commit));
+   }
 
-      mCommitsMap[sha] = commit;
-      mCommits[++count] = &mCommitsMap[sha];
+   return mRows.count();
+}
 
-      if (tmpChildsStorage.contains(sha))
-      {
-         for (const auto &child : qAsConst(tmpChildsStorage[sha]))
-            mCommitsMap[sha].appendChild(child);
+int GitCache::appendPage(QVector<CommitInfo> commits)
+{
+   QMutexLocker lock(&mCommitsMutex);
 
-         tmpChildsStorage.remove(sha);
-      }
+   // The lanes engine is left as the last commit of the previous page, so the graph continues from there. If the
+   // history changed in between, the commits that are already in the cache are not added again.
+   const auto known = [this](const CommitInfo &commit) { return mCommitsStore.hasData(mCommitsStore.idOf(commit.sha)); };
+   commits.erase(std::remove_if(commits.begin(), commits.end(), known), commits.end());
 
-      for (const auto &parent : qAsConst(mCommitsMap[sha].mParentsSha))
-         tmpChildsStorage[parent].append(&mCommitsMap[sha]);
-   }
+   const auto total = appendCommits(std::move(commits));
 
-   mCommitsMap.squeeze();
-   mCommits.squeeze();
+   scheduleLanesFill();
 
-   tmpChildsStorage.clear();
-   tmpChildsStorage.squeeze();
+   return total;
 }
 
-CommitInfo GitCache::commitInfo(int row)
+void GitCache::finishSetup()
 {
    QMutexLocker lock(&mCommitsMutex);
 
-   const auto commit = row >= 0 && row < mCommits.count() ? mCommits.at(row) : nullptr;
+   mCommitsStore.squeeze();
+   mRows.squeeze();
 
-   return commit ? *commit : CommitInfo();
+   scheduleLanesFill();
 }
 
-auto GitCache::searchCommit(const QString &text, const int startingPoint) const
+void GitCache::restore(CommitStore store, QVector<int> rows)
 {
-   return std::find_if(mCommits.constBegin() + startingPoint, mCommits.constEnd(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   TRACE_SPAN("Cache", "Restore");
+
+   QMutexLocker lock(&mCommitsMutex);
+
+   QLog_Debug("Cache", QString("Restoring {%1} revisions from the history cache.").arg(rows.count()));
+
+   mInitialized = true;
+   mConfigured = false;
+   mCommitsStore = std::move(store);
+   mRows = std::move(rows);
+
+   // The cache is only written once all the lanes are computed.
+   mLanes.clear();
+   mLaneCheckpoints.clear();
+   mLanesRow = mRows.count();
 }
 
-auto GitCache::reverseSearchCommit(const QString &text, int startingPoint) const
+bool GitCache::persist(const HistoryCacheFile &file, const HistoryCacheFile::Header &header) const
 {
-   const auto startEndPos = startingPoint > 0 ? mCommits.count() - startingPoint + 1 : 0;
+   TRACE_SPAN("Cache", "Persist");
+
+   CommitStore store;
+   QVector<int> rows;
 
-   return std::find_if(mCommits.crbegin() + startEndPos, mCommits.crend(),
-                       [text](CommitInfo *info) { return info->contains(text); });
+   {
+      // The columns are implicitly shared, so the copy is cheap and the file is written without blocking the UI.
+      QMutexLocker lock(&mCommitsMutex);
+      store = mCommitsStore;
+      rows = mRows;
+   }
+
+   QLog_Debug("Cache", QString("Writing {%1} revisions into the history cache.").arg(rows.count()));
+
+   return file.write(header, store, rows);
 }
 
-CommitInfo GitCache::searchCommitInfo(const QString &text, int startingPoint, bool reverse)
+CommitInfo GitCache::commitInfo(int row)
 {
    QMutexLocker lock(&mCommitsMutex);
-   CommitInfo commit;
 
-   if (!reverse)
-   {
-      auto commitIter = searchCommit(text, startingPoint);
+   return row >= 0 && row < mRows.count() ? commitFromStore(mRows.at(row)) : CommitInfo();
+}
 
-      if (commitIter == mCommits.constEnd())
-         commitIter = searchCommit(text);
+int GitCache::searchCommit(const QString &text, const int startingPoint) const
+{
+   const auto total = mRows.count();
 
-      if (commitIter != mCommits.constEnd())
-         commit = **commitIter;
-   }
-   else
+   for (auto row = startingPoint; row < total; ++row)
    {
-      auto commitIter = reverseSearchCommit(text, startingPoint);
+      if (mCommitsStore.contains(mRows.at(row), text))
+         return row;
+   }
 
-      if (commitIter == mCommits.crend())
-         commitIter = reverseSearchCommit(text);
+   return -1;
+}
+
+int GitCache::reverseSearchCommit(const QString &text, int startingPoint) const
+{
+   const auto start = startingPoint > 0 ? std::min(startingPoint - 2, mRows.count() - 1) : mRows.count() - 1;
 
-      if (commitIter != mCommits.crend())
-         commit = **commitIter;
+   for (auto row = start; row >= 0; --row)
+   {
+      if (mCommitsStore.contains(mRows.at(row), text))
+         return row;
    }
 
-   return commit;
+   return -1;
+}
+
+CommitInfo GitCache::searchCommitInfo(const QString &text, int startingPoint, bool reverse)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   auto row = reverse ? reverseSearchCommit(text, startingPoint) : searchCommit(text, startingPoint);
+
+   if (row == -1)
+      row = reverse ? reverseSearchCommit(text) : searchCommit(text);
+
+   return row != -1 ? commitFromStore(mRows.at(row)) : CommitInfo();
 }
 
 bool GitCache::isCommitInCurrentGeneologyTree(const QString &sha)
@@ -144,33 +270,128 @@ CommitInfo GitCache::commitInfo(const QString &sha)
 {
    QMutexLocker lock(&mCommitsMutex);
 
-   if (!sha.isEmpty())
+   if (sha.isEmpty())
+      return CommitInfo();
+
+   auto id = mCommitsStore.idOf(sha);
+
+   if (!mCommitsStore.hasData(id))
+      id = mCommitsStore.idOfPrefix(sha);
+
+   return commitFromStore(id);
+}
+
+bool GitCache::hasCommitBody(const QString &sha)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   if (!mLazyBodies)
+      return true;
+
+   const auto id = mCommitsStore.idOf(sha);
+
+   // Commits created from GitQlient are inserted with their body.
+   return mBodies.contains(ObjectId::fromString(sha))
+       || (mCommitsStore.hasData(id) && mCommitsStore.hasLongLog(id));
+}
+
+void GitCache::insertCommitBody(const QString &sha, const QString &body)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   if (const auto objectId = ObjectId::fromString(sha); objectId.isValid())
+      mBodies.insert(objectId, new QString(body), std::max(1, body.length()));
+}
+
+bool GitCache::hasCommitText(int row)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   return row < 0 || row >= mRows.count() || !mCommitsStore.hasData(mRows.at(row))
+       || mCommitsStore.hasText(mRows.at(row));
+}
+
+bool GitCache::requestCommitText(int row)
+{
+   if (hasCommitText(row))
+      return true;
+
+   // The texts are loaded in the loader thread, signalCommitTextsLoaded is emitted once they are in the cache.
+   emit signalCommitTextsRequested(row);
+
+   return false;
+}
+
+bool GitCache::hasMissingCommitTexts()
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   return std::any_of(mRows.cbegin(), mRows.cend(),
+                      [this](int id) { return mCommitsStore.hasData(id) && !mCommitsStore.hasText(id); });
+}
+
+QStringList GitCache::missingCommitTexts(int firstRow, int count)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   QStringList shas;
+   const auto lastRow = std::min(firstRow + count, mRows.count());
+
+   for (auto row = std::max(firstRow, 0); row < lastRow; ++row)
    {
-      const auto c = mCommitsMap.value(sha, CommitInfo());
+      if (const auto id = mRows.at(row); mCommitsStore.hasData(id) && !mCommitsStore.hasText(id))
+         shas.append(mCommitsStore.sha(id));
+   }
 
-      if (!c.isValid())
-      {
-         const auto shas = mCommitsMap.keys();
-         const auto it = std::find_if(shas.cbegin(), shas.cend(),
-                                      [sha](const QString &shaToCompare) { return shaToCompare.startsWith(sha); });
+   return shas;
+}
 
-         if (it != shas.cend())
-            return mCommitsMap.value(*it);
+void GitCache::insertCommitTexts(const QVector<CommitInfo> &commits)
+{
+   if (commits.isEmpty())
+      return;
 
-         return CommitInfo();
-      }
+   {
+      QMutexLocker lock(&mCommitsMutex);
 
-      return c;
+      for (const auto &commit : commits)
+         mCommitsStore.setText(mCommitsStore.idOf(commit.sha), commit);
    }
 
-   return CommitInfo();
+   emit signalCommitTextsLoaded();
+}
+
+void GitCache::setLazyBodies(bool lazyBodies)
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   mLazyBodies = lazyBodies;
+}
+
+CommitInfo GitCache::commitFromStore(int id)
+{
+   auto commit = mCommitsStore.commit(id);
+
+   if (mLazyBodies && commit.longLog.isEmpty() && mCommitsStore.hasData(id))
+   {
+      if (const auto body = mBodies.object(mCommitsStore.objectId(id)))
+         commit.longLog = *body;
+   }
+
+   return commit;
 }
 
 std::optional<RevisionFiles> GitCache::revisionFile(const QString &sha1, const QString &sha2) const
 {
    QMutexLocker lock(&mRevisionsMutex);
 
-   const auto iter = mRevisionFilesMap.constFind(qMakePair(sha1, sha2));
+   const auto key = qMakePair(ObjectId::fromString(sha1), ObjectId::fromString(sha2));
+
+   // Only the WIP can be stored without a parent, any other invalid SHA has no entry.
+   if (!key.first.isValid() || (!sha2.isEmpty() && !key.second.isValid()))
+      return std::nullopt;
+
+   const auto iter = mRevisionFilesMap.constFind(key);
 
    if (iter != mRevisionFilesMap.cend())
       return *iter;
@@ -191,7 +412,9 @@ void GitCache::insertWipRevision(const WipRevisionInfo &wipInfo)
 
    QLog_Debug("Cache", QString("Updating the WIP commit. The actual parent has SHA {%1}.").arg(newParentSha));
 
-   const auto fakeRevFile = fakeWorkDirRevFile(wipInfo.diffIndex, wipInfo.diffIndexCached);
+   const auto &fakeRevFile = wipInfo.files;
+
+   mUntrackedFiles = wipInfo.untrackedFiles;
 
    insertRevisionFile(CommitInfo::ZERO_SHA, newParentSha, fakeRevFile);
 
@@ -200,18 +423,27 @@ void GitCache::insertWipRevision(const WipRevisionInfo &wipInfo)
    if (!newParentSha.isEmpty())
       parents.append(newParentSha);
 
-   if (mLanes.isEmpty())
-      mLanes.init(CommitInfo::ZERO_SHA);
-
    const auto log = fakeRevFile.count() == mUntrackedFiles.count() ? tr("No local changes") : tr("Local changes");
    CommitInfo c(CommitInfo::ZERO_SHA, parents, std::chrono::seconds(QDateTime::currentSecsSinceEpoch()), log);
-   calculateLanes(c);
 
-   if (mCommits[0])
-      c.setLanes(mCommits[0]->lanes());
+   if (mRows.isEmpty())
+      mRows.append(CommitStore::INVALID_ID);
+
+   const auto hadLanes = mCommitsStore.hasData(mRows.constFirst());
+   const auto lanes = hadLanes ? mCommitsStore.lanes(mRows.constFirst()) : QVector<Lane>();
+   const auto wipId = mCommitsStore.insert(c);
 
-   mCommitsMap.insert(CommitInfo::ZERO_SHA, std::move(c));
-   mCommits[0] = &mCommitsMap[CommitInfo::ZERO_SHA];
+   mRows[0] = wipId;
+
+   if (hadLanes)
+      mCommitsStore.setLanes(wipId, lanes);
+   else
+   {
+      mLanes.init(wipId);
+      mLaneCheckpoints.clear();
+      mLanesRow = 0;
+      computeLanesUpTo(0);
+   }
 }
 
 bool GitCache::insertRevisionFiles(const QString &sha1, const QString &sha2, const RevisionFiles &file)
@@ -223,8 +455,8 @@ bool GitCache::insertRevisionFiles(const QString &sha1, const QString &sha2, con
 
 bool GitCache::insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file)
 {
-   const auto key = qMakePair(sha1, sha2);
-   const auto emptyShas = !sha1.isEmpty() && !sha2.isEmpty();
+   const auto key = qMakePair(ObjectId::fromString(sha1), ObjectId::fromString(sha2));
+   const auto emptyShas = key.first.isValid() && key.second.isValid();
    const auto isWip = sha1 == CommitInfo::ZERO_SHA;
 
    if ((emptyShas || isWip) && mRevisionFilesMap.value(key) != file)
@@ -245,28 +477,30 @@ void GitCache::insertReference(const QString &sha, References::Type type, const
 
    QLog_Trace("Cache", QString("Adding a new reference with SHA {%1}.").arg(sha));
 
-   mReferences[sha].addReference(type, reference);
+   mReferences[ObjectId::fromString(sha)].addReference(type, reference);
 }
 
 void GitCache::deleteReference(const QString &sha, References::Type type, const QString &reference)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   mReferences[sha].removeReference(type, reference);
+   mReferences[ObjectId::fromString(sha)].removeReference(type, reference);
 }
 
 bool GitCache::hasReferences(const QString &sha)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   return mReferences.contains(sha) && !mReferences.value(sha).isEmpty();
+   const auto iter = mReferences.constFind(ObjectId::fromString(sha));
+
+   return iter != mReferences.cend() && !iter->isEmpty();
 }
 
 QStringList GitCache::getReferences(const QString &sha, References::Type type)
 {
    QMutexLocker lock(&mReferencesMutex);
 
-   return mReferences.value(sha).getReferences(type);
+   return mReferences.value(ObjectId::fromString(sha)).getReferences(type);
 }
 
 QString GitCache::getShaOfReference(const QString &referenceName, References::Type type) const
@@ -279,7 +513,7 @@ QString GitCache::getShaOfReference(const QString &referenceName, References::Ty
 
       for (const auto &reference : references)
          if (reference == referenceName)
-            return iter.key();
+            return iter.key().toString();
    }
 
    return QString();
@@ -305,7 +539,7 @@ void GitCache::reloadCurrentBranchInfo(const QString &currentBranch, const QStri
       }
    }
 
-   mReferences[currentSha].addReference(References::Type::LocalBranch, currentBranch);
+   mReferences[ObjectId::fromString(currentSha)].addReference(References::Type::LocalBranch, currentBranch);
 }
 
 bool GitCache::updateWipCommit(const WipRevisionInfo &wipInfo)
@@ -326,23 +560,27 @@ void GitCache::insertCommit(CommitInfo commit)
 {
    QMutexLocker lock2(&mCommitsMutex);
 
-   const auto sha = commit.sha;
-   const auto parentSha = commit.firstParent();
+   const auto wipId = mRows.constFirst();
+   const auto parentId = mCommitsStore.idOf(commit.firstParent());
 
    commit.setLanes({ LaneType::ACTIVE });
    commit.pos = 1;
 
-   mCommitsMap[sha] = std::move(commit);
-   mCommitsMap[sha].appendChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
+   const auto id = mCommitsStore.insert(commit);
+   mCommitsStore.appendChild(id, wipId);
+   mCommitsStore.removeChild(parentId, wipId);
 
-   mCommitsMap[parentSha].removeChild(&mCommitsMap[CommitInfo::ZERO_SHA]);
-   mCommitsMap[parentSha].appendChild(&mCommitsMap[sha]);
-
-   const auto total = mCommits.count();
+   const auto total = mRows.count();
    for (auto i = 1; i < total; ++i)
-      ++mCommits[i]->pos;
+      mCommitsStore.setPosition(mRows.at(i), mCommitsStore.position(mRows.at(i)) + 1);
+
+   mRows.insert(1, id);
 
-   mCommits.insert(1, &mCommitsMap[sha]);
+   // The lanes of the new commit are already set, the rest of the computed rows move one position down.
+   if (mLanesRow > 1)
+      ++mLanesRow;
+
+   mLaneCheckpoints.erase(mLaneCheckpoints.upperBound(1), mLaneCheckpoints.end());
 }
 
 void GitCache::updateCommit(const QString &oldSha, CommitInfo newCommit)
@@ -350,19 +588,18 @@ void GitCache::updateCommit(const QString &oldSha, CommitInfo newCommit)
    QMutexLocker lock(&mCommitsMutex);
    QMutexLocker lock2(&mRevisionsMutex);
 
-   auto &oldCommit = mCommitsMap[oldSha];
-   const auto oldCommitParens = oldCommit.parents();
+   const auto oldId = mCommitsStore.idOf(oldSha);
+   const auto children = mCommitsStore.children(oldId);
    const auto newCommitSha = newCommit.sha;
 
-   mCommitsMap.remove(oldSha);
-   mCommitsMap.insert(newCommitSha, std::move(newCommit));
-   mCommits[1] = &mCommitsMap[newCommitSha];
+   mCommitsStore.remove(oldId);
 
-   for (const auto &parent : oldCommitParens)
-   {
-      mCommitsMap[parent].removeChild(&oldCommit);
-      mCommitsMap[parent].appendChild(&mCommitsMap[newCommitSha]);
-   }
+   const auto newId = mCommitsStore.insert(newCommit);
+
+   for (const auto child : children)
+      mCommitsStore.appendChild(newId, child);
+
+   mRows[1] = newId;
 
    const auto tags = getReferences(oldSha, References::Type::LocalTag);
    for (const auto &tag : tags)
@@ -379,31 +616,291 @@ void GitCache::updateCommit(const QString &oldSha, CommitInfo newCommit)
    }
 }
 
-void GitCache::calculateLanes(CommitInfo &c)
+bool GitCache::computeLanes(int row)
 {
-   const auto sha = c.sha;
+   // The rows above the frontier never lose their lanes, so the common case doesn't wait for the background fill.
+   if (row < mLanesRow)
+      return true;
 
-   QLog_Trace("Cache", QString("Updating the lanes for SHA {%1}.").arg(sha));
+   QMutexLocker lock(&mCommitsMutex);
 
-   bool isDiscontinuity;
-   bool isFork = mLanes.isFork(sha, isDiscontinuity);
-   bool isMerge = c.parentsCount() > 1;
+   // A far jump would compute all the rows in between in the GUI thread. The view paints the row without graph and
+   // it's notified when the background fill reaches it.
+   if (!mLanes.isEmpty() && row - mLanesRow >= LANES_PAINT_LIMIT)
+   {
+      mLanesAwaitedRow = std::max(mLanesAwaitedRow, row);
+      scheduleLanesFill();
 
-   if (isDiscontinuity)
-      mLanes.changeActiveLane(sha);
+      return false;
+   }
 
-   if (isFork)
-      mLanes.setFork(sha);
-   if (isMerge)
-      mLanes.setMerge(c.parents());
-   if (c.parentsCount() == 0)
-      mLanes.setInitial();
+   computeLanesUpTo(row + LANES_LOOKAHEAD);
+
+   return true;
+}
+
+void GitCache::computeLanesUpTo(int lastRow)
+{
+   if (mLanes.isEmpty() || lastRow < mLanesRow)
+      return;
+
+   TRACE_SPAN("Cache", "Compute lanes");
+
+   const auto initId = mCommitsStore.idOf(ObjectId::fromString(CommitInfo::INIT_SHA));
+   const auto last = std::min(lastRow, mRows.count() - 1);
+
+   for (auto row = mLanesRow.load(); row <= last; ++row)
+   {
+      if (row % LANES_CHECKPOINT_INTERVAL == 0)
+         mLaneCheckpoints.insert(row, mLanes);
+
+      if (const auto id = mRows.at(row); id != CommitStore::INVALID_ID)
+         mCommitsStore.setLanes(id, nextLanes(mLanes, id, mCommitsStore.parents(id), initId));
 
-   const auto lanes = mLanes.getLanes();
+      mLanesRow = row + 1;
+   }
+}
+
+void GitCache::scheduleLanesFill()
+{
+   if (mLanesFillScheduled || lanesComplete())
+      return;
+
+   mLanesFillScheduled = true;
+
+   // The fill runs in the thread of the cache in small batches, so the loader and the view are never kept waiting.
+   QTimer::singleShot(0, this, &GitCache::fillLanes);
+}
+
+void GitCache::fillLanes()
+{
+   QMutexLocker lock(&mCommitsMutex);
 
-   resetLanes(c, isFork);
+   mLanesFillScheduled = false;
 
-   c.setLanes(std::move(lanes));
+   computeLanesUpTo(mLanesRow + LANES_FILL_BATCH - 1);
+
+   const auto complete = lanesComplete();
+   const auto awaitedRowReached = mLanesAwaitedRow != -1 && (mLanesAwaitedRow < mLanesRow || complete);
+
+   if (awaitedRowReached)
+      mLanesAwaitedRow = -1;
+
+   if (!complete)
+      scheduleLanesFill();
+
+   lock.unlock();
+
+   if (awaitedRowReached)
+      emit signalLanesComputed();
+
+   if (complete)
+   {
+      QLog_Debug("Cache", QString("Lanes computed for {%1} rows.").arg(mLanesRow.load()));
+
+      emit signalLanesCompleted();
+   }
+}
+
+bool GitCache::lanesComplete() const
+{
+   QMutexLocker lock(&mCommitsMutex);
+
+   return mLanes.isEmpty() || mLanesRow >= mRows.count();
+}
+
+QVector<int> GitCache::spliceCommits(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits)
+{
+   TRACE_SPAN("Cache", "Splice commits");
+
+   QMutexLocker lock(&mRevisionsMutex);
+   QMutexLocker lock2(&mCommitsMutex);
+
+   QLog_Debug("Cache", QString("Splicing {%1} new revisions into the cache.").arg(commits.count()));
+
+   if (mRows.isEmpty())
+      mRows.append(CommitStore::INVALID_ID);
+
+   const auto oldRows = mRows;
+   const auto oldWipParent = mCommitsStore.firstParent(oldRows.constFirst());
+
+   QVector<int> newIds;
+   QSet<int> newIdsSet;
+   newIds.reserve(commits.count());
+
+   for (const auto &commit : qAsConst(commits))
+   {
+      // Commits created from GitQlient are already in the cache.
+      if (mCommitsStore.hasData(mCommitsStore.idOf(commit.sha)))
+         continue;
+
+      if (const auto id = mCommitsStore.insert(commit); id != CommitStore::INVALID_ID)
+      {
+         newIds.append(id);
+         newIdsSet.insert(id);
+      }
+   }
+
+   // The new revisions are never ancestors of the ones in the cache, so they are placed by date as long as they come
+   // before their parents.
+   QHash<int, int> pendingChildren;
+
+   for (const auto id : qAsConst(newIds))
+   {
+      const auto parents = mCommitsStore.parents(id);
+
+      for (const auto parent : parents)
+      {
+         if (!newIdsSet.contains(parent))
+            ++pendingChildren[parent];
+      }
+   }
+
+   QVector<int> rows;
+   rows.reserve(oldRows.count() + newIds.count());
+   rows.append(oldRows.constFirst());
+
+   auto next = 0;
+   const auto appendNew = [&]() {
+      const auto id = newIds.at(next++);
+      const auto parents = mCommitsStore.parents(id);
+
+      for (const auto parent : parents)
+      {
+         if (const auto iter = pendingChildren.find(parent); iter != pendingChildren.end())
+            --iter.value();
+      }
+
+      rows.append(id);
+   };
+
+   for (auto row = 1; row < oldRows.count(); ++row)
+   {
+      const auto id = oldRows.at(row);
+
+      while (next < newIds.count()
+             && (pendingChildren.value(id) > 0 || mCommitsStore.date(newIds.at(next)) >= mCommitsStore.date(id)))
+         appendNew();
+
+      rows.append(id);
+   }
+
+   while (next < newIds.count())
+      appendNew();
+
+   mRows = std::move(rows);
+
+   insertWipRevision(wipInfo);
+
+   // Only the rows from the first new revision (or the WIP, if HEAD moved) onwards can change.
+   auto firstRow = mCommitsStore.firstParent(mRows.constFirst()) != oldWipParent ? 0 : mRows.count();
+   QVector<int> insertedRows;
+   insertedRows.reserve(newIds.count());
+
+   for (auto row = 1; row < mRows.count(); ++row)
+   {
+      if (newIdsSet.contains(mRows.at(row)))
+      {
+         firstRow = std::min(firstRow, row);
+         insertedRows.append(row);
+      }
+   }
+
+   for (auto row = firstRow; row < mRows.count(); ++row)
+      mCommitsStore.setPosition(mRows.at(row), row);
+
+   if (firstRow < mRows.count())
+      recalculateLanes(firstRow, oldRows, oldWipParent, newIdsSet);
+
+   return insertedRows;
+}
+
+void GitCache::recalculateLanes(int firstRow, const QVector<int> &oldRows, int oldWipParent, const QSet<int> &newIds)
+{
+   TRACE_SPAN("Cache", "Recalculate lanes");
+
+   // Nothing that was computed changed: the new rows are computed on demand like the rest.
+   if (firstRow >= mLanesRow)
+   {
+      scheduleLanesFill();
+      return;
+   }
+
+   const auto wipId = mRows.constFirst();
+   const auto initId = mCommitsStore.idOf(ObjectId::fromString(CommitInfo::INIT_SHA));
+   const auto oldParents = [&](int row) {
+      if (row > 0)
+         return mCommitsStore.parents(oldRows.at(row));
+
+      return oldWipParent != CommitStore::INVALID_ID ? QVector<int> { oldWipParent } : QVector<int>();
+   };
+
+   // The engine is replayed from the nearest checkpoint over the rows that didn't change. The checkpoints after the
+   // first changed row belong to the previous order.
+   Lanes lanes;
+   auto row = 0;
+
+   if (auto checkpoint = mLaneCheckpoints.upperBound(firstRow); checkpoint != mLaneCheckpoints.begin())
+   {
+      --checkpoint;
+      row = checkpoint.key();
+      lanes = checkpoint.value();
+   }
+   else
+      lanes.init(wipId);
+
+   mLaneCheckpoints.erase(mLaneCheckpoints.upperBound(firstRow), mLaneCheckpoints.end());
+
+   for (; row < firstRow; ++row)
+   {
+      const auto id = mRows.at(row);
+
+      nextLanes(lanes, id, mCommitsStore.parents(id), initId);
+   }
+
+   // A second engine follows the previous order so the computation can stop as soon as both reach the same state:
+   // the lanes of the remaining rows are still valid. The rows that had no lanes yet are left for later.
+   const auto oldLanesRow = mLanesRow.load();
+   auto oldLanes = lanes;
+   auto pendingNew = newIds.count();
+   auto oldRow = firstRow;
+   auto converged = false;
+
+   for (; row < mRows.count() && oldRow < oldLanesRow; ++row)
+   {
+      if (row % LANES_CHECKPOINT_INTERVAL == 0)
+         mLaneCheckpoints.insert(row, lanes);
+
+      const auto id = mRows.at(row);
+
+      mCommitsStore.setLanes(id, nextLanes(lanes, id, mCommitsStore.parents(id), initId));
+
+      if (newIds.contains(id))
+      {
+         --pendingNew;
+         continue;
+      }
+
+      nextLanes(oldLanes, id, oldParents(oldRow++), initId);
+
+      if (pendingNew == 0 && lanes == oldLanes)
+      {
+         converged = true;
+         ++row;
+         break;
+      }
+   }
+
+   if (converged)
+      mLanesRow = oldLanesRow + row - oldRow;
+   else
+   {
+      mLanes = lanes;
+      mLanesRow = row;
+      scheduleLanesFill();
+   }
+
+   QLog_Debug("Cache", QString("Lanes recalculated from row {%1} to row {%2}.").arg(firstRow).arg(row));
 }
 
 bool GitCache::pendingLocalChanges()
@@ -413,7 +910,7 @@ bool GitCache::pendingLocalChanges()
 
    auto localChanges = false;
 
-   if (const auto commit = mCommitsMap.value(CommitInfo::ZERO_SHA, CommitInfo()); commit.isValid())
+   if (const auto commit = mCommitsStore.commit(mCommitsStore.idOf(CommitInfo::ZERO_SHA)); commit.isValid())
    {
       if (const auto rf = revisionFile(CommitInfo::ZERO_SHA, commit.firstParent()); rf)
          localChanges = rf.value().count() - mUntrackedFiles.count() > 0;
@@ -428,7 +925,7 @@ QVector<QPair<QString, QStringList>> GitCache::getBranches(References::Type type
    QVector<QPair<QString, QStringList>> branches;
 
    for (auto iter = mReferences.cbegin(); iter != mReferences.cend(); ++iter)
-      branches.append(QPair<QString, QStringList>(iter.key(), iter.value().getReferences(type)));
+      branches.append(QPair<QString, QStringList>(iter.key().toString(), iter.value().getReferences(type)));
 
    return branches;
 }
@@ -444,7 +941,7 @@ QMap<QString, QString> GitCache::getTags(References::Type tagType) const
       const auto tagNames = iter->getReferences(tagType);
 
       for (const auto &tag : tagNames)
-         tags[tag] = iter.key();
+         tags[tag] = iter.key().toString();
    }
 
    return tags;
@@ -460,86 +957,51 @@ void GitCache::updateTags(QMap<QString, QString> remoteTags)
    emit signalCacheUpdated();
 }
 
-void GitCache::resetLanes(const CommitInfo &c, bool isFork)
-{
-   const auto nextSha = c.parentsCount() == 0 ? QString() : c.firstParent();
-
-   mLanes.nextParent(nextSha);
-
-   if (c.parentsCount() > 1)
-      mLanes.afterMerge();
-   if (isFork)
-      mLanes.afterFork();
-   if (mLanes.isBranch())
-      mLanes.afterBranch();
-}
 
 bool GitCache::checkSha(const QString &originalSha, const QString &currentSha) const
 {
    if (originalSha == currentSha)
       return true;
 
-   if (const auto iter = mCommitsMap.find(currentSha); iter != mCommitsMap.cend())
-      return checkSha(originalSha, iter->firstParent());
+   const auto originalId = mCommitsStore.idOf(originalSha);
+   auto id = mCommitsStore.idOf(currentSha);
+
+   while (id != CommitStore::INVALID_ID)
+   {
+      if (id == originalId)
+         return true;
+
+      if (!mCommitsStore.hasData(id))
+         break;
+
+      id = mCommitsStore.firstParent(id);
+   }
 
    return false;
 }
 
 void GitCache::clearInternalData()
 {
-   mCommits.clear();
-   mCommits.squeeze();
-   mCommitsMap.clear();
-   mCommitsMap.squeeze();
+   mCommitsStore.clear();
+   mRows.clear();
+   mRows.squeeze();
+   mBodies.clear();
    mReferences.clear();
    mRevisionFilesMap.clear();
    mRevisionFilesMap.squeeze();
    mUntrackedFiles.clear();
    mUntrackedFiles.squeeze();
    mLanes.clear();
+   mLaneCheckpoints.clear();
+   mLanesRow = 0;
+   mLanesAwaitedRow = -1;
    mReferences.clear();
    mReferences.squeeze();
 }
 
 int GitCache::commitCount() const
 {
-   return mCommits.count();
-}
-
-RevisionFiles GitCache::fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache)
-{
-   RevisionFiles rf(diffIndex);
-   rf.setOnlyModified(false);
-
-   for (const auto &it : qAsConst(mUntrackedFiles))
-   {
-      rf.mFiles.append(it);
-      rf.setStatus(RevisionFiles::UNKNOWN);
-      rf.mergeParent.append(1);
-   }
-
-   RevisionFiles cachedFiles(diffIndexCache, true);
-
-   for (auto i = 0; i < rf.count(); i++)
-   {
-      if (const auto cachedIndex = cachedFiles.mFiles.indexOf(rf.getFile(i)); cachedIndex != -1)
-      {
-         if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::CONFLICT))
-            rf.appendStatus(i, RevisionFiles::CONFLICT);
-         else if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::MODIFIED)
-                  && cachedFiles.statusCmp(cachedIndex, RevisionFiles::IN_INDEX))
-            rf.appendStatus(i, RevisionFiles::PARTIALLY_CACHED);
-         else if (cachedFiles.statusCmp(cachedIndex, RevisionFiles::IN_INDEX))
-            rf.appendStatus(i, RevisionFiles::IN_INDEX);
-      }
-   }
-
-   return rf;
-}
+   QMutexLocker lock(&mCommitsMutex);
 
-void GitCache::setUntrackedFilesList(QVector<QString> untrackedFiles)
-{
-   mUntrackedFiles.clear();
-   mUntrackedFiles.squeeze();
-   mUntrackedFiles = std::move(untrackedFiles);
+   return mRows.count();
 }
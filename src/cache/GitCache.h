@@ -24,14 +24,20 @@
  ***************************************************************************************/
 
 #include <CommitInfo.h>
+#include <CommitStore.h>
+#include <HistoryCacheFile.h>
 #include <RevisionFiles.h>
 #include <lanes.h>
 
+#include <QCache>
 #include <QHash>
+#include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QSet>
 #include <QSharedPointer>
 
+#include <atomic>
 #include <optional>
 
 struct WipRevisionInfo;
@@ -42,6 +48,10 @@ class GitCache : public QObject
 
 signals:
    void signalCacheUpdated();
+   void signalLanesCompleted();
+   void signalLanesComputed();
+   void signalCommitTextsRequested(int row);
+   void signalCommitTextsLoaded();
 
 public:
    struct LocalBranchDistances
@@ -63,6 +73,15 @@ public:
    void insertCommit(CommitInfo commit);
    void updateCommit(const QString &oldSha, CommitInfo newCommit);
 
+   bool hasCommitBody(const QString &sha);
+   void insertCommitBody(const QString &sha, const QString &body);
+   bool computeLanes(int row);
+   bool hasCommitText(int row);
+   bool requestCommitText(int row);
+   bool hasMissingCommitTexts();
+   QStringList missingCommitTexts(int firstRow, int count);
+   void insertCommitTexts(const QVector<CommitInfo> &commits);
+
    bool insertRevisionFiles(const QString &sha1, const QString &sha2, const RevisionFiles &file);
    std::optional<RevisionFiles> revisionFile(const QString &sha1, const QString &sha2) const;
 
@@ -74,7 +93,6 @@ public:
    QString getShaOfReference(const QString &referenceName, References::Type type) const;
    void reloadCurrentBranchInfo(const QString &currentBranch, const QString &currentSha);
 
-   void setUntrackedFilesList(QVector<QString> untrackedFiles);
    bool pendingLocalChanges();
 
    QVector<QPair<QString, QStringList>> getBranches(References::Type type);
@@ -86,32 +104,54 @@ public:
 
 private:
    friend class GitRepoLoader;
+   friend class CacheBenchmark;
 
    bool mInitialized = false;
    bool mConfigured = true;
+   // The lanes are computed on demand: mLanes is the state of the engine at mLanesRow, the first row without lanes.
+   // The state before every LANES_CHECKPOINT_INTERVAL rows is kept so the lanes can be recomputed from there.
    Lanes mLanes;
+   std::atomic<int> mLanesRow { 0 };
+   QMap<int, Lanes> mLaneCheckpoints;
+   bool mLanesFillScheduled = false;
+   // The last row the view painted without lanes, or -1. signalLanesComputed is emitted once the fill reaches it.
+   int mLanesAwaitedRow = -1;
    QVector<QString> mUntrackedFiles;
 
    mutable QMutex mCommitsMutex;
-   QVector<CommitInfo *> mCommits;
-   QHash<QString, CommitInfo> mCommitsMap;
+   CommitStore mCommitsStore;
+   QVector<int> mRows;
+   bool mLazyBodies = false;
+   QCache<ObjectId, QString> mBodies;
 
    mutable QMutex mRevisionsMutex;
-   QHash<QPair<QString, QString>, RevisionFiles> mRevisionFilesMap;
+   QHash<QPair<ObjectId, ObjectId>, RevisionFiles> mRevisionFilesMap;
 
    mutable QMutex mReferencesMutex;
-   QHash<QString, References> mReferences;
+   QHash<ObjectId, References> mReferences;
 
    void setup(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits);
+   void setupTopology(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits);
+   void beginSetup(const WipRevisionInfo &wipInfo, int expectedCommits = 0);
+   int appendCommits(QVector<CommitInfo> commits);
+   int appendPage(QVector<CommitInfo> commits);
+   void finishSetup();
    void setConfigurationDone() { mConfigured = true; }
+   void restore(CommitStore store, QVector<int> rows);
+   QVector<int> spliceCommits(const WipRevisionInfo &wipInfo, QVector<CommitInfo> commits);
+   void recalculateLanes(int firstRow, const QVector<int> &oldRows, int oldWipParent, const QSet<int> &newIds);
+   bool persist(const HistoryCacheFile &file, const HistoryCacheFile::Header &header) const;
+   void setLazyBodies(bool lazyBodies);
+   CommitInfo commitFromStore(int id);
 
    bool insertRevisionFile(const QString &sha1, const QString &sha2, const RevisionFiles &file);
    void insertWipRevision(const WipRevisionInfo &wipInfo);
-   RevisionFiles fakeWorkDirRevFile(const QString &diffIndex, const QString &diffIndexCache);
-   void calculateLanes(CommitInfo &c);
-   auto searchCommit(const QString &text, int startingPoint = 0) const;
-   auto reverseSearchCommit(const QString &text, int startingPoint = 0) const;
-   void resetLanes(const CommitInfo &c, bool isFork);
+   void computeLanesUpTo(int lastRow);
+   void scheduleLanesFill();
+   void fillLanes();
+   bool lanesComplete() const;
+   int searchCommit(const QString &text, int startingPoint = 0) const;
+   int reverseSearchCommit(const QString &text, int startingPoint = 0) const;
    bool checkSha(const QString &originalSha, const QString &currentSha) const;
    void clearInternalData();
 };
@@ -0,0 +1,295 @@
+#include "HistoryCacheFile.h"
+
+#include <CommitStore.h>
+#include <LaneType.h>
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+const quint32 MAGIC = 0x43485147; // "GQHC"
+const quint32 VERSION = 3;
+
+template<typename T>
+void writeValue(QIODevice &device, const T &value)
+{
+   device.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(const char *&cursor, const char *end, T &value)
+{
+   if (static_cast<size_t>(end - cursor) < sizeof(T))
+      return false;
+
+   std::memcpy(&value, cursor, sizeof(T));
+   cursor += sizeof(T);
+
+   return true;
+}
+
+template<typename T>
+void writeColumn(QIODevice &device, const QVector<T> &column)
+{
+   static_assert(std::is_trivially_copyable_v<T>, "The columns are written as raw memory.");
+
+   writeValue(device, static_cast<quint32>(column.count()));
+   device.write(reinterpret_cast<const char *>(column.constData()),
+                static_cast<qint64>(column.count()) * static_cast<qint64>(sizeof(T)));
+}
+
+template<typename T>
+bool readColumn(const char *&cursor, const char *end, QVector<T> &column)
+{
+   quint32 count = 0;
+
+   if (!readValue(cursor, end, count))
+      return false;
+
+   const auto bytes = static_cast<size_t>(count) * sizeof(T);
+
+   if (static_cast<size_t>(end - cursor) < bytes)
+      return false;
+
+   column.resize(static_cast<int>(count));
+   std::memcpy(column.data(), cursor, bytes);
+   cursor += bytes;
+
+   return true;
+}
+
+void writeBytes(QIODevice &device, const QByteArray &bytes)
+{
+   writeValue(device, static_cast<quint32>(bytes.size()));
+   device.write(bytes);
+}
+
+bool readBytes(const char *&cursor, const char *end, QByteArray &bytes)
+{
+   quint32 size = 0;
+
+   if (!readValue(cursor, end, size) || static_cast<quint32>(end - cursor) < size)
+      return false;
+
+   bytes = QByteArray(cursor, static_cast<int>(size));
+   cursor += size;
+
+   return true;
+}
+
+bool readHeader(const char *&cursor, const char *end, HistoryCacheFile::Header &header)
+{
+   quint32 magic = 0;
+   quint32 version = 0;
+   QByteArray options;
+
+   if (!readValue(cursor, end, magic) || magic != MAGIC || !readValue(cursor, end, version) || version != VERSION
+       || !readBytes(cursor, end, options) || !readColumn(cursor, end, header.tips))
+   {
+      return false;
+   }
+
+   header.options = QString::fromUtf8(options);
+
+   return true;
+}
+}
+
+HistoryCacheFile::HistoryCacheFile(const QString &path)
+   : mPath(path)
+{
+}
+
+std::optional<HistoryCacheFile::Header> HistoryCacheFile::readHeader() const
+{
+   QFile file(mPath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return std::nullopt;
+
+   const auto size = file.size();
+   const auto data = file.map(0, size);
+
+   if (!data)
+      return std::nullopt;
+
+   auto cursor = reinterpret_cast<const char *>(data);
+   Header header;
+   const auto valid = ::readHeader(cursor, cursor + size, header);
+
+   file.unmap(data);
+
+   return valid ? std::make_optional(header) : std::nullopt;
+}
+
+bool HistoryCacheFile::read(Header &header, CommitStore &store, QVector<int> &rows) const
+{
+   QFile file(mPath);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto size = file.size();
+   const auto data = file.map(0, size);
+
+   if (!data)
+      return false;
+
+   auto cursor = reinterpret_cast<const char *>(data);
+   const auto end = cursor + size;
+
+   store.clear();
+
+   QVector<CommitStore::TextRef> identityRefs;
+   QByteArray identityText;
+   QVector<quint32> laneOffsets;
+   QVector<quint8> laneTypes;
+
+   auto valid = ::readHeader(cursor, end, header) && readColumn(cursor, end, rows)
+       && readColumn(cursor, end, store.mShas) && readColumn(cursor, end, store.mFlags)
+       && readColumn(cursor, end, store.mDates) && readColumn(cursor, end, store.mPositions)
+       && readColumn(cursor, end, store.mCommitters) && readColumn(cursor, end, store.mAuthors)
+       && readColumn(cursor, end, store.mShortLogs) && readColumn(cursor, end, store.mLongLogs)
+       && readColumn(cursor, end, store.mGpgKeys) && readColumn(cursor, end, store.mParentRanges)
+       && readColumn(cursor, end, store.mParents) && readColumn(cursor, end, store.mChildRanges)
+       && readColumn(cursor, end, store.mChildren) && readBytes(cursor, end, store.mText)
+       && readColumn(cursor, end, identityRefs) && readBytes(cursor, end, identityText)
+       && readColumn(cursor, end, store.mLaneRows) && readColumn(cursor, end, laneOffsets)
+       && readColumn(cursor, end, laneTypes);
+
+   file.unmap(data);
+
+   const auto total = store.mShas.count();
+
+   valid = valid && store.mFlags.count() == total && store.mDates.count() == total
+       && store.mPositions.count() == total && store.mCommitters.count() == total && store.mAuthors.count() == total
+       && store.mShortLogs.count() == total && store.mLongLogs.count() == total && store.mGpgKeys.count() == total
+       && store.mParentRanges.count() == total && store.mChildRanges.count() == total
+       && !laneOffsets.isEmpty() && identityRefs.count() % 2 == 0;
+
+   valid = valid && std::all_of(identityRefs.cbegin(), identityRefs.cend(), [&identityText](const auto &ref) {
+              return static_cast<quint64>(ref.offset) + ref.size <= static_cast<quint64>(identityText.size());
+           });
+
+   // The lane types are cast to the enum, a value out of it would be painted as an unknown lane.
+   valid = valid && std::all_of(laneTypes.cbegin(), laneTypes.cend(), [](quint8 type) {
+              return type < static_cast<quint8>(LaneType::LANE_TYPES_NUM);
+           });
+
+   // The rows and the positions index the columns of the store. The first row is the WIP, that can have no commit.
+   valid = valid && !rows.isEmpty()
+       && (rows.constFirst() == CommitStore::INVALID_ID || (rows.constFirst() >= 0 && rows.constFirst() < total));
+
+   valid = valid && std::all_of(rows.cbegin() + 1, rows.cend(), [&store, total](int id) {
+              return id >= 0 && id < total && (store.mFlags.at(id) & CommitStore::HasData);
+           });
+
+   valid = valid && std::all_of(store.mPositions.cbegin(), store.mPositions.cend(), [&rows](int position) {
+              return position >= -1 && position < rows.count();
+           });
+
+   if (valid)
+   {
+      const auto text = [&identityText](const CommitStore::TextRef &ref) {
+         return QString::fromUtf8(identityText.constData() + ref.offset, static_cast<int>(ref.size));
+      };
+
+      for (auto i = 0; i < identityRefs.count(); i += 2)
+         store.mIdentities.append({ text(identityRefs.at(i)), text(identityRefs.at(i + 1)) });
+
+      store.mLaneTable.reserve(laneOffsets.count() - 1);
+
+      for (auto row = 0; row + 1 < laneOffsets.count(); ++row)
+      {
+         QVector<Lane> lanes;
+         const auto first = static_cast<int>(laneOffsets.at(row));
+         const auto last = static_cast<int>(laneOffsets.at(row + 1));
+         lanes.reserve(std::max(0, last - first));
+
+         for (auto i = first; i < last && i < laneTypes.count(); ++i)
+            lanes.append(Lane(static_cast<LaneType>(laneTypes.at(i))));
+
+         store.mLaneTable.append(std::move(lanes));
+      }
+
+      valid = store.rebuildIndexes();
+   }
+
+   if (!valid)
+   {
+      store.clear();
+      rows.clear();
+   }
+
+   return valid;
+}
+
+bool HistoryCacheFile::write(const Header &header, const CommitStore &store, const QVector<int> &rows) const
+{
+   QSaveFile file(mPath);
+
+   if (!file.open(QIODevice::WriteOnly))
+      return false;
+
+   writeValue(file, MAGIC);
+   writeValue(file, VERSION);
+   writeBytes(file, header.options.toUtf8());
+   writeColumn(file, header.tips);
+   writeColumn(file, rows);
+
+   writeColumn(file, store.mShas);
+   writeColumn(file, store.mFlags);
+   writeColumn(file, store.mDates);
+   writeColumn(file, store.mPositions);
+   writeColumn(file, store.mCommitters);
+   writeColumn(file, store.mAuthors);
+   writeColumn(file, store.mShortLogs);
+   writeColumn(file, store.mLongLogs);
+   writeColumn(file, store.mGpgKeys);
+   writeColumn(file, store.mParentRanges);
+   writeColumn(file, store.mParents);
+   writeColumn(file, store.mChildRanges);
+   writeColumn(file, store.mChildren);
+   writeBytes(file, store.mText);
+
+   QVector<CommitStore::TextRef> identityRefs;
+   QByteArray identityText;
+   identityRefs.reserve(store.mIdentities.count() * 2);
+
+   for (const auto &identity : store.mIdentities)
+   {
+      for (const auto &text : { identity.name, identity.email })
+      {
+         const auto utf8 = text.toUtf8();
+         identityRefs.append({ static_cast<quint32>(identityText.size()), static_cast<quint32>(utf8.size()) });
+         identityText.append(utf8);
+      }
+   }
+
+   writeColumn(file, identityRefs);
+   writeBytes(file, identityText);
+
+   QVector<quint32> laneOffsets;
+   QVector<quint8> laneTypes;
+   laneOffsets.reserve(store.mLaneTable.count() + 1);
+   laneOffsets.append(0);
+
+   for (const auto &lanes : store.mLaneTable)
+   {
+      for (const auto &lane : lanes)
+         laneTypes.append(static_cast<quint8>(lane.getType()));
+
+      laneOffsets.append(static_cast<quint32>(laneTypes.count()));
+   }
+
+   writeColumn(file, store.mLaneRows);
+   writeColumn(file, laneOffsets);
+   writeColumn(file, laneTypes);
+
+   return file.commit();
+}
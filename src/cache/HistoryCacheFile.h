@@ -0,0 +1,77 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <ObjectId.h>
+
+#include <QString>
+#include <QVector>
+
+#include <optional>
+
+class CommitStore;
+
+/**
+ * @brief The HistoryCacheFile class persists the computed history of a repository (the commit store with the
+ * topology and the lanes, and the order of the rows) so it can be restored without running git log again.
+ *
+ * The file is versioned and keyed by the options used to load the history and the tips of the references the history
+ * was loaded from. It is read through a memory map and every column of the store is copied in a single block, so
+ * there is no parsing per commit.
+ */
+class HistoryCacheFile
+{
+public:
+   struct Header
+   {
+      QString options;
+      QVector<ObjectId> tips;
+   };
+
+   explicit HistoryCacheFile(const QString &path);
+
+   /**
+    * @brief readHeader Reads only the header of the file, to decide if the cache can be used.
+    * @return The header if the file exists and has the current version.
+    */
+   std::optional<Header> readHeader() const;
+
+   /**
+    * @brief read Reads the whole file.
+    *
+    * @param header The header stored in the file.
+    * @param store The store where the commits are read.
+    * @param rows The ids of the commits in the order of the rows.
+    * @return True if the file was valid.
+    */
+   bool read(Header &header, CommitStore &store, QVector<int> &rows) const;
+
+   /**
+    * @brief write Writes the file. The previous file is only replaced if all the data was written.
+    */
+   bool write(const Header &header, const CommitStore &store, const QVector<int> &rows) const;
+
+private:
+   QString mPath;
+};
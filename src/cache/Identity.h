@@ -0,0 +1,66 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QString>
+
+#include <string_view>
+
+/**
+ * @brief The Identity struct is the name and email of an author or a committer, split once when the log is parsed
+ * instead of every time they are displayed.
+ */
+struct Identity
+{
+   QString name;
+   QString email;
+
+   /**
+    * @brief fromUtf8 Parses an identity with the "Name<email>" format used by the log.
+    */
+   static Identity fromUtf8(std::string_view identity)
+   {
+      const auto separator = identity.find('<');
+
+      if (separator == std::string_view::npos)
+         return { QString::fromUtf8(identity.data(), static_cast<int>(identity.size())), QString() };
+
+      auto email = identity.substr(separator + 1);
+
+      if (!email.empty() && email.back() == '>')
+         email.remove_suffix(1);
+
+      return { QString::fromUtf8(identity.data(), static_cast<int>(separator)),
+               QString::fromUtf8(email.data(), static_cast<int>(email.size())) };
+   }
+
+   QString toString() const { return QString(name % QChar('<') % email % QChar('>')); }
+   bool isEmpty() const { return name.isEmpty() && email.isEmpty(); }
+
+   bool operator==(const Identity &other) const { return name == other.name && email == other.email; }
+   bool operator!=(const Identity &other) const { return !(*this == other); }
+
+   friend uint qHash(const Identity &identity, uint seed = 0) { return qHash(identity.name, seed) ^ qHash(identity.email); }
+};
@@ -23,7 +23,9 @@
  ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  ***************************************************************************************/
 
-enum class LaneType;
+#include <QHash>
+
+enum class LaneType : quint8;
 
 class Lane
 {
@@ -47,3 +49,8 @@ public:
 private:
    LaneType mType;
 };
+
+inline uint qHash(const Lane &lane, uint seed = 0) noexcept
+{
+   return qHash(static_cast<quint8>(lane.getType()), seed);
+}
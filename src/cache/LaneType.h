@@ -1,6 +1,9 @@
 #pragma once
 
-enum class LaneType
+#include <QtGlobal>
+
+// One byte per lane: the lanes of every commit are kept in memory and in the history cache.
+enum class LaneType : quint8
 {
    EMPTY,
    ACTIVE,
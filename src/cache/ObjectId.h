@@ -0,0 +1,204 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QString>
+
+#include <array>
+
+/**
+ * @brief The ObjectId class is the binary form of a Git object name (SHA-1). It is exactly the 20 bytes of the name,
+ * with no padding, so it can be copied and written to disk as raw memory. The ordering of two ids is the same as the
+ * ordering of their hexadecimal representation.
+ *
+ * A default-constructed ObjectId is invalid. It is not the same as the all-zeros id used for the working directory: an
+ * invalid id has all its bytes set to 0xFF, a name that Git will never produce in practice.
+ */
+class ObjectId
+{
+public:
+   static constexpr int RAW_SIZE = 20;
+   static constexpr int HEX_SIZE = 40;
+
+   constexpr ObjectId()
+   {
+      for (auto i = 0; i < RAW_SIZE; ++i)
+         mBytes[i] = INVALID_BYTE;
+   }
+
+   /**
+    * @brief fromHex Parses the 40 hexadecimal characters of @p hex. Upper and lower case are accepted.
+    * @return An invalid ObjectId if @p length is not 40 or a character is not hexadecimal.
+    */
+   static constexpr ObjectId fromHex(const char *hex, int length) { return parse(hex, length); }
+   template<int N>
+   static constexpr ObjectId fromHex(const char (&hex)[N])
+   {
+      return parse(hex, N - 1);
+   }
+   static ObjectId fromString(const QString &sha) { return parse(sha.constData(), sha.length()); }
+
+   /**
+    * @brief fromRaw Reads the 20 bytes of a binary object name, as Git stores them in its own files.
+    */
+   static constexpr ObjectId fromRaw(const uchar *raw)
+   {
+      ObjectId id;
+
+      for (auto i = 0; i < RAW_SIZE; ++i)
+         id.mBytes[i] = raw[i];
+
+      return id;
+   }
+
+   constexpr bool isValid() const
+   {
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         if (mBytes[i] != INVALID_BYTE)
+            return true;
+      }
+
+      return false;
+   }
+
+   /**
+    * @brief nibble Returns the value of the hexadecimal digit at @p index, being 0 the most significant one.
+    */
+   constexpr int nibble(int index) const
+   {
+      const auto byte = mBytes[index / 2];
+
+      return index % 2 == 0 ? byte >> 4 : byte & 0xF;
+   }
+
+   constexpr std::array<char, HEX_SIZE> toHex() const
+   {
+      std::array<char, HEX_SIZE> hex {};
+
+      for (auto i = 0; i < HEX_SIZE; ++i)
+         hex[static_cast<size_t>(i)] = "0123456789abcdef"[nibble(i)];
+
+      return hex;
+   }
+
+   QString toString() const
+   {
+      if (!isValid())
+         return QString();
+
+      const auto hex = toHex();
+
+      return QString::fromLatin1(hex.data(), HEX_SIZE);
+   }
+
+   /**
+    * @brief startsWith Checks if the hexadecimal form of the id starts with @p prefix, ignoring the case.
+    */
+   bool startsWith(const QString &prefix) const
+   {
+      const auto length = prefix.length();
+
+      if (length == 0 || length > HEX_SIZE || !isValid())
+         return false;
+
+      for (auto i = 0; i < length; ++i)
+      {
+         if (hexValue(code(prefix.at(i))) != nibble(i))
+            return false;
+      }
+
+      return true;
+   }
+
+   constexpr bool operator==(const ObjectId &other) const { return compare(other) == 0; }
+   constexpr bool operator!=(const ObjectId &other) const { return compare(other) != 0; }
+   constexpr bool operator<(const ObjectId &other) const { return compare(other) < 0; }
+
+   // The bytes of a SHA-1 are already uniformly distributed, so the first four are good enough as hash.
+   friend constexpr uint qHash(const ObjectId &id, uint seed = 0)
+   {
+      return ((static_cast<uint>(id.mBytes[0]) << 24) | (static_cast<uint>(id.mBytes[1]) << 16)
+              | (static_cast<uint>(id.mBytes[2]) << 8) | static_cast<uint>(id.mBytes[3]))
+          ^ seed;
+   }
+
+private:
+   static constexpr quint8 INVALID_BYTE = 0xFF;
+
+   quint8 mBytes[RAW_SIZE] {};
+
+   constexpr int compare(const ObjectId &other) const
+   {
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         if (mBytes[i] != other.mBytes[i])
+            return mBytes[i] < other.mBytes[i] ? -1 : 1;
+      }
+
+      return 0;
+   }
+
+   static constexpr int code(char c) { return static_cast<unsigned char>(c); }
+   static constexpr int code(QChar c) { return c.unicode(); }
+
+   static constexpr int hexValue(int c)
+   {
+      if (c >= '0' && c <= '9')
+         return c - '0';
+      if (c >= 'a' && c <= 'f')
+         return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+         return c - 'A' + 10;
+
+      return -1;
+   }
+
+   template<typename Char>
+   static constexpr ObjectId parse(const Char *hex, int length)
+   {
+      ObjectId id;
+
+      if (length != HEX_SIZE)
+         return id;
+
+      for (auto i = 0; i < RAW_SIZE; ++i)
+      {
+         const auto high = hexValue(code(hex[2 * i]));
+         const auto low = hexValue(code(hex[2 * i + 1]));
+
+         if (high < 0 || low < 0)
+            return ObjectId();
+
+         id.mBytes[i] = static_cast<quint8>((high << 4) | low);
+      }
+
+      return id;
+   }
+};
+
+// The ids are written raw to the history cache, so there can't be any padding.
+static_assert(sizeof(ObjectId) == ObjectId::RAW_SIZE, "ObjectId must be exactly the 20 bytes of the SHA-1");
+
+Q_DECLARE_TYPEINFO(ObjectId, Q_PRIMITIVE_TYPE);
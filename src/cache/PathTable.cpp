@@ -0,0 +1,125 @@
+#include "PathTable.h"
+
+PathTable *PathTable::getInstance()
+{
+   static PathTable table;
+
+   return &table;
+}
+
+PathTable::PathTable()
+{
+   mNodes.append({ INVALID_ID, QString() });
+}
+
+int PathTable::intern(const QString &path)
+{
+   if (path.isEmpty())
+      return ROOT_ID;
+
+   auto position = 0;
+
+   {
+      QReadLocker lock(&mLock);
+
+      if (const auto node = walk(path, position); position == -1)
+         return node;
+   }
+
+   QWriteLocker lock(&mLock);
+
+   // Another thread could have added part of the path in between.
+   auto node = walk(path, position);
+
+   while (position != -1)
+   {
+      const auto end = path.indexOf('/', position);
+      const auto component = path.mid(position, end == -1 ? -1 : end - position);
+      const auto child = mNodes.count();
+
+      mNodes.append({ node, component });
+      mChildren.insert(qMakePair(node, component), child);
+
+      node = child;
+      position = end == -1 ? -1 : end + 1;
+   }
+
+   return node;
+}
+
+int PathTable::find(const QString &path) const
+{
+   if (path.isEmpty())
+      return ROOT_ID;
+
+   QReadLocker lock(&mLock);
+
+   auto position = 0;
+   const auto node = walk(path, position);
+
+   return position == -1 ? node : INVALID_ID;
+}
+
+QString PathTable::path(int id) const
+{
+   QReadLocker lock(&mLock);
+   QStringList components;
+
+   for (; id > ROOT_ID; id = mNodes.at(id).parent)
+      components.prepend(mNodes.at(id).name);
+
+   return components.join('/');
+}
+
+QString PathTable::name(int id) const
+{
+   QReadLocker lock(&mLock);
+
+   return mNodes.at(id).name;
+}
+
+int PathTable::parent(int id) const
+{
+   QReadLocker lock(&mLock);
+
+   return mNodes.at(id).parent;
+}
+
+bool PathTable::isInside(int id, int directory) const
+{
+   QReadLocker lock(&mLock);
+
+   while (id > ROOT_ID && id != directory)
+      id = mNodes.at(id).parent;
+
+   return id == directory;
+}
+
+int PathTable::count() const
+{
+   QReadLocker lock(&mLock);
+
+   return mNodes.count();
+}
+
+int PathTable::walk(const QString &path, int &position) const
+{
+   auto node = ROOT_ID;
+
+   position = 0;
+
+   while (position != -1)
+   {
+      const auto end = path.indexOf('/', position);
+      const auto child
+          = mChildren.value(qMakePair(node, path.mid(position, end == -1 ? -1 : end - position)), INVALID_ID);
+
+      if (child == INVALID_ID)
+         break;
+
+      node = child;
+      position = end == -1 ? -1 : end + 1;
+   }
+
+   return node;
+}
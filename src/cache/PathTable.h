@@ -0,0 +1,93 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief The PathTable class interns the paths of the changed files as a trie of their components. Every path is
+ * identified by an integer id: the id of its last component, that points to the id of its directory. The commits of a
+ * repository touch the same directories again and again, so every component is stored once and RevisionFiles only
+ * keeps the ids.
+ *
+ * The directories are paths too, so the files can be grouped by directory comparing ids.
+ *
+ * There is one table for the application. It's thread-safe and it only grows.
+ */
+class PathTable
+{
+public:
+   static const int INVALID_ID = -1;
+   static const int ROOT_ID = 0;
+
+   static PathTable *getInstance();
+
+   /**
+    * @brief intern Returns the id of @p path, adding it if it isn't in the table.
+    */
+   int intern(const QString &path);
+
+   /**
+    * @brief find Returns the id of @p path, or INVALID_ID if it was never interned.
+    */
+   int find(const QString &path) const;
+
+   QString path(int id) const;
+   QString name(int id) const;
+   int parent(int id) const;
+
+   /**
+    * @brief isInside Returns true if @p id is @p directory or any path under it.
+    */
+   bool isInside(int id, int directory) const;
+
+   int count() const;
+
+private:
+   struct Node
+   {
+      int parent;
+      QString name;
+   };
+
+   mutable QReadWriteLock mLock;
+   QVector<Node> mNodes;
+   QHash<QPair<int, QString>, int> mChildren;
+
+   PathTable();
+
+   /**
+    * @brief walk Follows the components of @p path that are in the table. The lock must be held.
+    *
+    * @param path The path.
+    * @param position Returns the start of the first component that isn't in the table, or -1 if the whole path is.
+    * @return The id of the last component found.
+    */
+   int walk(const QString &path, int &position) const;
+};
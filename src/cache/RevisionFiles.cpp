@@ -3,39 +3,40 @@
 RevisionFiles::RevisionFiles(const QString &diff, bool cached)
 {
    auto parNum = 1;
+   const auto length = diff.length();
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto lines = diff.split("\n", Qt::SkipEmptyParts);
-#else
-   const auto lines = diff.split("\n", QString::SkipEmptyParts);
-#endif
-
-   for (auto line : lines)
+   // The lines are read in place: the fields of the raw format are at fixed positions.
+   for (auto start = 0; start < length;)
    {
-      if (line[0] == ':') // avoid sha's in merges output
+      auto end = diff.indexOf('\n', start);
+
+      if (end == -1)
+         end = length;
+
+      const auto line = diff.midRef(start, end - start);
+
+      start = end + 1;
+
+      if (line.isEmpty())
+         continue;
+
+      if (line.at(0) == ':') // avoid sha's in merges output
       {
-         if (line[1] == ':')
+         if (line.length() > 1 && line.at(1) == ':')
          {
-            mFiles.append(line.section('\t', -1));
-            setStatus("M");
-            mergeParent.append(parNum);
+            appendFile(line.mid(line.lastIndexOf('\t') + 1).toString(), parNum);
+            parseStatus('M', false);
          }
-         else
+         else if (line.length() > 99 && line.at(98) == '\t') // Faster parsing in normal case
          {
-            if (line.at(98) == '\t') // Faster parsing in normal case
-            {
-               auto fields = line.split(" ");
-               const auto dstSha = fields.at(3);
-               auto fileIsCached = !dstSha.startsWith(QStringLiteral("000000"));
-               const auto flag = fields.at(4).at(0);
-
-               mFiles.append(line.mid(99));
-               setStatus(flag, cached ? cached : fileIsCached);
-               mergeParent.append(parNum);
-            }
-            else // It's a rename or a copy, we are not in fast path now!
-               setExtStatus(line.mid(97), parNum);
+            // ":<mode> <mode> <sha> <sha> <status>\t<path>", the destination SHA starts at 56.
+            const auto fileIsCached = line.mid(56, 6) != QLatin1String("000000");
+
+            appendFile(line.mid(99).toString(), parNum);
+            parseStatus(line.at(97), cached || fileIsCached);
          }
+         else if (line.length() > 97) // It's a rename or a copy, we are not in fast path now!
+            setExtStatus(line.mid(97).toString(), parNum);
       }
       else
          ++parNum;
@@ -50,18 +51,20 @@ RevisionFiles::~RevisionFiles()
    mRenamedFiles.squeeze();
    mergeParent.clear();
    mergeParent.squeeze();
-   mFiles.clear();
-   mFiles.squeeze();
+   mPaths.clear();
+   mPaths.squeeze();
+   mIndex.clear();
+   mIndex.squeeze();
 }
 
 bool RevisionFiles::isValid() const
 {
-   return !(mFiles.empty() && mFileStatus.empty() && mRenamedFiles.empty());
+   return !(mPaths.empty() && mFileStatus.empty() && mRenamedFiles.empty());
 }
 
 bool RevisionFiles::operator==(const RevisionFiles &revFiles) const
 {
-   return mFiles == revFiles.mFiles && mOnlyModified == revFiles.mOnlyModified && mergeParent == revFiles.mergeParent
+   return mPaths == revFiles.mPaths && mOnlyModified == revFiles.mOnlyModified && mergeParent == revFiles.mergeParent
        && mFileStatus == revFiles.mFileStatus && mRenamedFiles == revFiles.mRenamedFiles;
 }
 
@@ -70,6 +73,32 @@ bool RevisionFiles::operator!=(const RevisionFiles &revFiles) const
    return !(*this == revFiles);
 }
 
+int RevisionFiles::appendFile(const QString &file, int parent)
+{
+   const auto position = mPaths.count();
+   const auto pathId = PathTable::getInstance()->intern(file);
+
+   mPaths.append(pathId);
+   mergeParent.append(parent);
+
+   // A merge can list the same file for each parent. The first entry is the one that is found.
+   if (!mIndex.contains(pathId))
+      mIndex.insert(pathId, position);
+
+   return position;
+}
+
+QStringList RevisionFiles::getFiles() const
+{
+   QStringList files;
+   files.reserve(mPaths.count());
+
+   for (const auto pathId : mPaths)
+      files.append(PathTable::getInstance()->path(pathId));
+
+   return files;
+}
+
 bool RevisionFiles::statusCmp(int idx, RevisionFiles::StatusFlag sf) const
 {
    if (idx >= mFileStatus.count())
@@ -90,7 +119,12 @@ const QString RevisionFiles::extendedStatus(int idx) const
 
 void RevisionFiles::setStatus(const QString &rowSt, bool isStaged)
 {
-   switch (rowSt.at(0).toLatin1())
+   parseStatus(rowSt.at(0), isStaged);
+}
+
+void RevisionFiles::parseStatus(QChar status, bool isStaged)
+{
+   switch (status.toLatin1())
    {
       case 'M':
       case 'T':
@@ -163,16 +197,14 @@ void RevisionFiles::setExtStatus(const QString &rowSt, int parNum)
    const QString &dest = sl[2];
    const QString extStatusInfo(orig + " --> " + dest + " (" + QString::number(type.toInt()) + "%)");
 
-   mFiles.append(dest);
-   mergeParent.append(parNum);
+   appendFile(dest, parNum);
    setStatus(RevisionFiles::NEW);
    appendExtStatus(extStatusInfo);
 
    // simulate deleted orig file only in case of rename
    if (type.at(0) == 'R')
    {
-      mFiles.append(orig);
-      mergeParent.append(parNum);
+      appendFile(orig, parNum);
       setStatus(RevisionFiles::DELETED);
       appendExtStatus(extStatusInfo);
    }
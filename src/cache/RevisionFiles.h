@@ -1,6 +1,9 @@
 #pragma once
 
+#include <PathTable.h>
+
 #include <QByteArray>
+#include <QHash>
 #include <QStringList>
 #include <QVector>
 
@@ -29,10 +32,24 @@ public:
    bool operator!=(const RevisionFiles &revFiles) const;
 
    QVector<int> mergeParent;
-   QVector<QString> mFiles;
+
+   /**
+    * @brief appendFile Adds a file without status. The status is set next with setStatus().
+    *
+    * @param file The path of the file.
+    * @param parent The number of the parent the change is from, for merges.
+    * @return The position of the file.
+    */
+   int appendFile(const QString &file, int parent = 1);
+
+   /**
+    * @brief indexOf Returns the position of the first entry of @p file, or -1 if it's not in the revision. It's a
+    * hash lookup.
+    */
+   int indexOf(const QString &file) const { return mIndex.value(PathTable::getInstance()->find(file), -1); }
 
    // helper functions
-   int count() const { return mFiles.count(); }
+   int count() const { return mPaths.count(); }
    bool statusCmp(int idx, StatusFlag sf) const;
    const QString extendedStatus(int idx) const;
    void setStatus(const QString &rowSt, bool isStaged = false);
@@ -43,9 +60,15 @@ public:
    void setOnlyModified(bool onlyModified) { mOnlyModified = onlyModified; }
    int getFilesCount() const { return mFileStatus.size(); }
    void appendExtStatus(const QString &file) { mRenamedFiles.append(file); }
-   QString getFile(int index) const { return mFiles.at(index); }
-   QStringList getFiles() const { return mFiles.toList(); }
-   bool containsFile(const QString &fileName) { return mFiles.contains(fileName); }
+   QString getFile(int index) const { return PathTable::getInstance()->path(mPaths.at(index)); }
+   QStringList getFiles() const;
+   bool containsFile(const QString &fileName) const { return indexOf(fileName) != -1; }
+
+   /**
+    * @brief getPathId Returns the id of the path of a file in the PathTable, to group the files by directory without
+    * comparing strings.
+    */
+   int getPathId(int index) const { return mPaths.at(index); }
 
 private:
    // Status information is split in a flags vector and in a string
@@ -58,9 +81,14 @@ private:
    // files info.
    // When status of all the files is 'modified' then onlyModified is
    // set, this let us to do some optimization in this common case
+   // The paths are ids in the PathTable and the status flags fit in 16 bits, since the same files are in many
+   // revisions of the cache.
    bool mOnlyModified = true;
-   QVector<int> mFileStatus;
+   QVector<int> mPaths;
+   QVector<quint16> mFileStatus;
    QVector<QString> mRenamedFiles;
+   QHash<int, int> mIndex;
 
+   void parseStatus(QChar status, bool isStaged);
    void setExtStatus(const QString &rowSt, int parNum);
 };
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <RevisionFiles.h>
+
 #include <QString>
+#include <QVector>
 
 struct WipRevisionInfo
 {
    QString parentSha;
-   QString diffIndex;
-   QString diffIndexCached;
+   RevisionFiles files;
+   QVector<QString> untrackedFiles;
 
-   bool isValid() const { return !parentSha.isEmpty() || !diffIndex.isEmpty() || !diffIndexCached.isEmpty(); }
+   bool isValid() const { return !parentSha.isEmpty(); }
 };
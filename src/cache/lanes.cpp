@@ -8,42 +8,40 @@
 */
 #include "lanes.h"
 
-#include <QStringList>
-
-void Lanes::init(const QString &expectedSha)
+void Lanes::init(int expectedId)
 {
    clear();
    activeLane = 0;
-   add(LaneType::BRANCH, expectedSha, activeLane);
+   add(LaneType::BRANCH, expectedId, activeLane);
 }
 
 void Lanes::clear()
 {
    typeVec.clear();
    typeVec.squeeze();
-   nextShaVec.clear();
-   nextShaVec.squeeze();
+   nextIdVec.clear();
+   nextIdVec.squeeze();
 }
 
-bool Lanes::isFork(const QString &sha, bool &isDiscontinuity)
+bool Lanes::isFork(int id, bool &isDiscontinuity)
 {
-   int pos = findNextSha(sha, 0);
+   int pos = findNextId(id, 0);
    isDiscontinuity = activeLane != pos;
 
-   return pos == -1 ? false : findNextSha(sha, pos + 1) != -1;
+   return pos == -1 ? false : findNextId(id, pos + 1) != -1;
 }
 
-void Lanes::setFork(const QString &sha)
+void Lanes::setFork(int id)
 {
    auto rangeEnd = 0;
    auto idx = 0;
-   auto rangeStart = rangeEnd = idx = findNextSha(sha, 0);
+   auto rangeStart = rangeEnd = idx = findNextId(id, 0);
 
    while (idx != -1)
    {
       rangeEnd = idx;
       typeVec[idx].setType(LaneType::TAIL);
-      idx = findNextSha(sha, idx + 1);
+      idx = findNextId(id, idx + 1);
    }
 
    typeVec[activeLane].setType(NODE);
@@ -79,7 +77,7 @@ void Lanes::setFork(const QString &sha)
    }
 }
 
-void Lanes::setMerge(const QStringList &parents)
+void Lanes::setMerge(const QVector<int> &parents)
 {
    auto &t = typeVec[activeLane];
    auto wasFork = t.equals(NODE);
@@ -92,11 +90,11 @@ void Lanes::setMerge(const QStringList &parents)
 
    auto rangeStart = activeLane;
    auto rangeEnd = activeLane;
-   QStringList::const_iterator it(parents.constBegin());
+   auto it = parents.constBegin();
 
    for (++it; it != parents.constEnd(); ++it)
    { // skip first parent
-      int idx = findNextSha(*it, 0);
+      int idx = findNextId(*it, 0);
 
       if (idx != -1)
       {
@@ -160,7 +158,7 @@ void Lanes::setInitial()
       t.setType(LaneType::INITIAL);
 }
 
-void Lanes::changeActiveLane(const QString &sha)
+void Lanes::changeActiveLane(int id)
 {
    auto &t = typeVec[activeLane];
 
@@ -169,11 +167,11 @@ void Lanes::changeActiveLane(const QString &sha)
    else
       t.setType(LaneType::NOT_ACTIVE);
 
-   int idx = findNextSha(sha, 0);
+   int idx = findNextId(id, 0);
    if (idx != -1)
       typeVec[idx].setType(LaneType::ACTIVE);
    else
-      idx = add(LaneType::BRANCH, sha, activeLane);
+      idx = add(LaneType::BRANCH, id, activeLane);
 
    activeLane = idx;
 }
@@ -211,7 +209,7 @@ void Lanes::afterFork()
    while (typeVec.last().equals(LaneType::EMPTY))
    {
       typeVec.pop_back();
-      nextShaVec.pop_back();
+      nextIdVec.pop_back();
    }
 }
 
@@ -228,16 +226,16 @@ void Lanes::afterBranch()
    typeVec[activeLane].setType(LaneType::ACTIVE);
 }
 
-void Lanes::nextParent(const QString &sha)
+void Lanes::nextParent(int id)
 {
-   nextShaVec[activeLane] = sha;
+   nextIdVec[activeLane] = id;
 }
 
-int Lanes::findNextSha(const QString &next, int pos)
+int Lanes::findNextId(int next, int pos) const
 {
-   for (int i = pos; i < nextShaVec.count(); i++)
+   for (int i = pos; i < nextIdVec.count(); i++)
    {
-      if (nextShaVec[i] == next)
+      if (nextIdVec[i] == next)
          return i;
    }
 
@@ -257,7 +255,7 @@ int Lanes::findType(const LaneType type, int pos)
    return -1;
 }
 
-int Lanes::add(const LaneType type, const QString &next, int pos)
+int Lanes::add(const LaneType type, int next, int pos)
 {
    if (pos < typeVec.count())
    {
@@ -265,13 +263,13 @@ int Lanes::add(const LaneType type, const QString &next, int pos)
       if (pos != -1)
       {
          typeVec[pos].setType(type);
-         nextShaVec[pos] = next;
+         nextIdVec[pos] = next;
          return pos;
       }
    }
 
    typeVec.append(type);
-   nextShaVec.append(next);
+   nextIdVec.append(next);
    return typeVec.count() - 1;
 }
 
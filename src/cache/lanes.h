@@ -7,7 +7,6 @@
 #ifndef LANES_H
 #define LANES_H
 
-#include <QString>
 #include <QVector>
 
 #include <LaneType.h>
@@ -15,7 +14,7 @@
 
 //
 //  At any given time, the Lanes class represents a single revision (row) of the history graph.
-//  The Lanes class contains a vector of the sha1 hashes of the next commit to appear in each lane (column).
+//  The Lanes class contains a vector of the commit store ids of the next commit to appear in each lane (column).
 //  The Lanes class also contains a vector used to decide which glyph to draw on the history graph.
 //
 //  For each revision (row) (from recent (top) to ancient past (bottom)), the Lanes class is updated, and the
@@ -28,31 +27,37 @@ class Lanes
 {
 public:
    Lanes() = default;
-   bool isEmpty() { return typeVec.empty(); }
-   void init(const QString &expectedSha);
+   bool isEmpty() const { return typeVec.empty(); }
+   void init(int expectedId);
    void clear();
-   bool isFork(const QString &sha, bool &isDiscontinuity);
-   void setFork(const QString &sha);
-   void setMerge(const QStringList &parents);
+   bool isFork(int id, bool &isDiscontinuity);
+   void setFork(int id);
+   void setMerge(const QVector<int> &parents);
    void setInitial();
-   void changeActiveLane(const QString &sha);
+   void changeActiveLane(int id);
    void afterMerge();
    void afterFork();
    bool isBranch();
    void afterBranch();
-   void nextParent(const QString &sha);
+   void nextParent(int id);
    void setLanes(QVector<Lane> &ln) { ln = typeVec; } // O(1) vector is implicitly shared
    QVector<Lane> getLanes() const { return typeVec; }
+   // Two engines in the same state produce the same lanes for the same revisions from then on.
+   bool operator==(const Lanes &lanes) const
+   {
+      return activeLane == lanes.activeLane && typeVec == lanes.typeVec && nextIdVec == lanes.nextIdVec;
+   }
+   bool operator!=(const Lanes &lanes) const { return !(*this == lanes); }
 
 private:
-   int findNextSha(const QString &next, int pos);
+   int findNextId(int next, int pos) const;
    int findType(LaneType type, int pos);
-   int add(LaneType type, const QString &next, int pos);
+   int add(LaneType type, int next, int pos);
    bool isNode(Lane lane) const;
 
    int activeLane;
    QVector<Lane> typeVec; // Describes which glyphs should be drawn.
-   QVector<QString> nextShaVec; // The sha1 hashes of the next commit to appear in each lane (column).
+   QVector<int> nextIdVec; // The ids in the commit store of the next commit to appear in each lane (column).
    LaneType NODE = LaneType::MERGE_FORK;
    LaneType NODE_R = LaneType::MERGE_FORK_R;
    LaneType NODE_L = LaneType::MERGE_FORK_L;
@@ -3,6 +3,7 @@
 
 #include <GitBase.h>
 #include <GitCache.h>
+#include <GitCommitBodies.h>
 #include <GitHistory.h>
 #include <GitLocal.h>
 #include <GitQlientRole.h>
@@ -24,6 +25,8 @@ AmendWidget::AmendWidget(const QSharedPointer<GitCache> &cache, const QSharedPoi
 
 void AmendWidget::configure(const QString &sha)
 {
+   GitCommitBodies(mGit, mCache).load(sha);
+
    const auto commit = mCache->commitInfo(sha);
 
    ui->amendFrame->setVisible(true);
@@ -56,9 +59,8 @@ void AmendWidget::configure(const QString &sha)
 
       mCurrentSha = sha;
 
-      const auto author = commit.author.split("<");
-      ui->leAuthorName->setText(author.first());
-      ui->leAuthorEmail->setText(author.last().mid(0, author.last().count() - 1));
+      ui->leAuthorName->setText(commit.author.name);
+      ui->leAuthorEmail->setText(commit.author.email);
       ui->teDescription->setPlainText(commit.longLog.trimmed());
       ui->leCommitTitle->setText(commit.shortLog);
 
@@ -129,8 +131,8 @@ void AmendWidget::commitChanges()
                auto commit = mCache->commitInfo(mCurrentSha);
                const auto oldSha = commit.sha;
                commit.sha = newSha;
-               commit.committer = author;
-               commit.author = author;
+               commit.committer = { ui->leAuthorName->text(), ui->leAuthorEmail->text() };
+               commit.author = commit.committer;
 
                const auto log = msg.split("\n\n");
                commit.shortLog = log.constFirst();
@@ -3,6 +3,7 @@
 #include <CommitInfoWidget.h>
 #include <FileListWidget.h>
 #include <GitCache.h>
+#include <GitCommitBodies.h>
 
 #include <QDateTime>
 #include <QLabel>
@@ -55,6 +56,8 @@ void CommitInfoWidget::configure(const QString &sha)
 
    if (sha != CommitInfo::ZERO_SHA && !sha.isEmpty())
    {
+      GitCommitBodies(mGit, mCache).load(sha);
+
       const auto commit = mCache->commitInfo(sha);
 
       if (!commit.sha.isEmpty())
@@ -89,8 +89,8 @@ void WipWidget::commitChanges()
                                       std::chrono::seconds(QDateTime::currentDateTime().toSecsSinceEpoch()),
                                       ui->leCommitTitle->text() };
 
-               newCommit.committer = QString("%1<%2>").arg(committer.mUserName, committer.mUserEmail);
-               newCommit.author = QString("%1<%2>").arg(committer.mUserName, committer.mUserEmail);
+               newCommit.committer = { committer.mUserName, committer.mUserEmail };
+               newCommit.author = newCommit.committer;
                newCommit.longLog = ui->teDescription->toPlainText();
 
                mCache->insertCommit(newCommit);
@@ -53,6 +53,7 @@
 
 #include <FileDiffHighlighter.h>
 #include <LineNumberArea.h>
+#include <Tracer.h>
 
 #include <QLogger.h>
 
@@ -93,6 +94,8 @@ void FileDiffView::addNumberArea(LineNumberArea *numberArea)
 
 void FileDiffView::loadDiff(const QString &text, const QVector<ChunkDiffInfo::ChunkInfo> &fileDiffInfo)
 {
+   TRACE_SPAN("UI", "Load diff view");
+
    QLog_Trace("UI",
               QString("FileDiffView::loadDiff - {%1} move scroll to pos {%2}")
                   .arg(objectName(), QString::number(verticalScrollBar()->value())));
@@ -12,6 +12,7 @@
 #include <GitPatches.h>
 #include <GitQlientSettings.h>
 #include <LineNumberArea.h>
+#include <Tracer.h>
 
 #include <QDateTime>
 #include <QDir>
@@ -189,6 +190,9 @@ bool FileDiffWidget::reload()
 bool FileDiffWidget::configure(const QString &currentSha, const QString &previousSha, const QString &file,
                                bool isCached, bool editMode)
 {
+   TraceSpan span("UI", "Configure file diff");
+   span.setArgs(file);
+
    auto destFile = file;
 
    if (destFile.contains("-->"))
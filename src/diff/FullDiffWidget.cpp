@@ -5,6 +5,7 @@
 #include <GitCache.h>
 #include <GitHistory.h>
 #include <GitQlientStyles.h>
+#include <Tracer.h>
 
 #include <QLineEdit>
 #include <QPushButton>
@@ -187,6 +188,8 @@ void FullDiffWidget::moveChunkDown()
 
 void FullDiffWidget::loadDiff(const QString &sha, const QString &diffToSha, const QString &diffData)
 {
+   TRACE_SPAN("UI", "Load full diff");
+
    mCurrentSha = sha;
    mPreviousSha = diffToSha;
 
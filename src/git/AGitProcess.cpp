@@ -1,6 +1,7 @@
 #include "AGitProcess.h"
 
 #include <GitQlientSettings.h>
+#include <Tracer.h>
 #include <QTemporaryFile>
 #include <QTextStream>
 
@@ -120,6 +121,14 @@ AGitProcess::AGitProcess(const QString &workingDir)
 {
    setWorkingDirectory(mWorkingDirectory);
 
+   // Connected first so the span doesn't include the processing of the output.
+   connect(
+       this, static_cast<void (AGitProcess::*)(int, QProcess::ExitStatus)>(&AGitProcess::finished), this,
+       [this]() {
+          if (mTraceStart >= 0)
+             Tracer::getInstance()->addSpan("Git", "Run git", mTraceStart, mCommand);
+       },
+       Qt::DirectConnection);
    connect(this, &AGitProcess::readyReadStandardOutput, this, &AGitProcess::onReadyStandardOutput,
            Qt::DirectConnection);
    connect(this, static_cast<void (AGitProcess::*)(int, QProcess::ExitStatus)>(&AGitProcess::finished), this,
@@ -155,6 +164,9 @@ bool AGitProcess::execute(const QString &command)
 
    if (!arguments.isEmpty())
    {
+      TraceSpan span("Git", "Start git");
+      span.setArgs(mCommand);
+
       QStringList env = QProcess::systemEnvironment();
       env << "GIT_TRACE=0"; // avoid choking on debug traces
       env << "GIT_FLUSH=0"; // skip the fflush() in 'git log'
@@ -165,6 +177,9 @@ bool AGitProcess::execute(const QString &command)
       setEnvironment(env);
       setProgram(gitAlternative.isEmpty() ? arguments.takeFirst() : gitAlternative);
       setArguments(arguments);
+
+      mTraceStart = Tracer::getInstance()->isEnabled() ? Tracer::getInstance()->now() : -1;
+
       start();
 
       processStarted = waitForStarted();
@@ -47,9 +47,8 @@ protected:
    QString mCommand;
    bool mRealError = false;
    bool mCanceling = false;
+   qint64 mTraceStart = -1;
    bool execute(const QString &command);
    virtual void onFinished(int exitCode, QProcess::ExitStatus exitStatus);
-
-private:
-   void onReadyStandardOutput();
+   virtual void onReadyStandardOutput();
 };
@@ -0,0 +1,272 @@
+#include "CommitGraphFile.h"
+
+#include <QFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+const char SIGNATURE[] = { 'C', 'G', 'P', 'H' };
+const quint8 GRAPH_VERSION = 1;
+const quint8 SHA1_VERSION = 1;
+const int HEADER_SIZE = 8;
+const int CHUNK_ENTRY_SIZE = 12;
+const int FANOUT_SIZE = 256 * 4;
+const int COMMIT_DATA_SIZE = ObjectId::RAW_SIZE + 16;
+
+const quint32 CHUNK_FANOUT = 0x4f494446; // "OIDF"
+const quint32 CHUNK_OIDS = 0x4f49444c; // "OIDL"
+const quint32 CHUNK_COMMIT_DATA = 0x43444154; // "CDAT"
+const quint32 CHUNK_EXTRA_EDGES = 0x45444745; // "EDGE"
+
+const quint32 NO_PARENT = 0x70000000;
+const quint32 LAST_EDGE = 0x80000000;
+
+quint32 readUInt32(const uchar *data)
+{
+   return qFromBigEndian<quint32>(data);
+}
+}
+
+struct CommitGraphFile::Layer
+{
+   QFile file;
+   const uchar *fanout = nullptr;
+   const uchar *oids = nullptr;
+   const uchar *commitData = nullptr;
+   const uchar *extraEdges = nullptr;
+   quint32 extraEdgesCount = 0;
+   int count = 0;
+   int base = 0;
+};
+
+CommitGraphFile::CommitGraphFile(const QString &objectsDir)
+   : mObjectsDir(objectsDir)
+{
+}
+
+CommitGraphFile::~CommitGraphFile() = default;
+
+bool CommitGraphFile::open()
+{
+   mLayers.clear();
+   mCount = 0;
+
+   const auto infoDir = QString("%1/info").arg(mObjectsDir);
+
+   // Git gives priority to the single file when both exist.
+   if (const auto single = QString("%1/commit-graph").arg(infoDir); QFile::exists(single))
+   {
+      if (openLayer(single))
+         return true;
+   }
+   else
+   {
+      QFile chain(QString("%1/commit-graphs/commit-graph-chain").arg(infoDir));
+
+      if (chain.open(QIODevice::ReadOnly))
+      {
+         // The chain lists the files from the base one, so the positions of each file follow the previous ones.
+         const auto hashes = chain.readAll().split('\n');
+         auto valid = true;
+
+         for (const auto &line : hashes)
+         {
+            if (const auto hash = QString::fromUtf8(line.trimmed()); !hash.isEmpty())
+            {
+               valid = openLayer(QString("%1/commit-graphs/graph-%2.graph").arg(infoDir, hash));
+
+               if (!valid)
+                  break;
+            }
+         }
+
+         if (valid && !mLayers.isEmpty())
+            return true;
+      }
+   }
+
+   mLayers.clear();
+   mCount = 0;
+
+   return false;
+}
+
+bool CommitGraphFile::openLayer(const QString &path)
+{
+   auto layer = QSharedPointer<Layer>::create();
+   layer->file.setFileName(path);
+
+   if (!layer->file.open(QIODevice::ReadOnly))
+      return false;
+
+   const auto size = layer->file.size();
+   const auto data = size >= HEADER_SIZE ? layer->file.map(0, size) : nullptr;
+
+   if (!data || std::memcmp(data, SIGNATURE, sizeof(SIGNATURE)) != 0 || data[4] != GRAPH_VERSION
+       || data[5] != SHA1_VERSION || data[7] != mLayers.count())
+      return false;
+
+   const auto chunks = static_cast<int>(data[6]);
+
+   if (HEADER_SIZE + (chunks + 1) * CHUNK_ENTRY_SIZE > size)
+      return false;
+
+   qint64 oidsSize = 0;
+   qint64 commitDataSize = 0;
+
+   for (auto i = 0; i < chunks; ++i)
+   {
+      const auto entry = data + HEADER_SIZE + i * CHUNK_ENTRY_SIZE;
+      const auto offset = static_cast<qint64>(qFromBigEndian<quint64>(entry + 4));
+      const auto end = static_cast<qint64>(qFromBigEndian<quint64>(entry + CHUNK_ENTRY_SIZE + 4));
+
+      if (offset < 0 || offset > end || end > size)
+         return false;
+
+      switch (readUInt32(entry))
+      {
+         case CHUNK_FANOUT:
+            if (end - offset < FANOUT_SIZE)
+               return false;
+
+            layer->fanout = data + offset;
+            break;
+         case CHUNK_OIDS:
+            layer->oids = data + offset;
+            oidsSize = end - offset;
+            break;
+         case CHUNK_COMMIT_DATA:
+            layer->commitData = data + offset;
+            commitDataSize = end - offset;
+            break;
+         case CHUNK_EXTRA_EDGES:
+            layer->extraEdges = data + offset;
+            layer->extraEdgesCount = static_cast<quint32>((end - offset) / 4);
+            break;
+         default:
+            break;
+      }
+   }
+
+   if (!layer->fanout || !layer->oids || !layer->commitData)
+      return false;
+
+   const auto count = static_cast<qint64>(readUInt32(layer->fanout + FANOUT_SIZE - 4));
+
+   if (count * ObjectId::RAW_SIZE > oidsSize || count * COMMIT_DATA_SIZE > commitDataSize
+       || mCount + count > std::numeric_limits<int>::max())
+      return false;
+
+   layer->count = static_cast<int>(count);
+   layer->base = mCount;
+
+   mCount += layer->count;
+   mLayers.append(layer);
+
+   return true;
+}
+
+const CommitGraphFile::Layer *CommitGraphFile::layerOf(int position) const
+{
+   for (const auto &layer : mLayers)
+   {
+      if (position < layer->base + layer->count)
+         return position >= layer->base ? layer.data() : nullptr;
+   }
+
+   return nullptr;
+}
+
+int CommitGraphFile::position(const ObjectId &sha) const
+{
+   if (!sha.isValid())
+      return -1;
+
+   const auto firstByte = sha.nibble(0) << 4 | sha.nibble(1);
+
+   for (const auto &layer : mLayers)
+   {
+      auto low = firstByte > 0 ? static_cast<int>(readUInt32(layer->fanout + (firstByte - 1) * 4)) : 0;
+      auto high = std::min(static_cast<int>(readUInt32(layer->fanout + firstByte * 4)), layer->count);
+      const auto last = high;
+
+      while (low < high)
+      {
+         const auto middle = low + (high - low) / 2;
+
+         if (ObjectId::fromRaw(layer->oids + middle * ObjectId::RAW_SIZE) < sha)
+            low = middle + 1;
+         else
+            high = middle;
+      }
+
+      if (low < last && ObjectId::fromRaw(layer->oids + low * ObjectId::RAW_SIZE) == sha)
+         return layer->base + low;
+   }
+
+   return -1;
+}
+
+ObjectId CommitGraphFile::objectId(int position) const
+{
+   const auto layer = layerOf(position);
+
+   return layer ? ObjectId::fromRaw(layer->oids + (position - layer->base) * ObjectId::RAW_SIZE) : ObjectId();
+}
+
+qint64 CommitGraphFile::commitDate(int position) const
+{
+   const auto layer = layerOf(position);
+
+   if (!layer)
+      return 0;
+
+   // The date has 34 bits: the two upper ones share the word with the generation number.
+   const auto entry = layer->commitData + (position - layer->base) * COMMIT_DATA_SIZE + ObjectId::RAW_SIZE;
+
+   return static_cast<qint64>(readUInt32(entry + 8) & 0x3) << 32 | readUInt32(entry + 12);
+}
+
+QVector<int> CommitGraphFile::parents(int position) const
+{
+   QVector<int> parents;
+   const auto layer = layerOf(position);
+
+   if (!layer)
+      return parents;
+
+   const auto entry = layer->commitData + (position - layer->base) * COMMIT_DATA_SIZE + ObjectId::RAW_SIZE;
+
+   if (const auto first = readUInt32(entry); first != NO_PARENT)
+      parents.append(static_cast<int>(first));
+   else
+      return parents;
+
+   const auto second = readUInt32(entry + 4);
+
+   if (second == NO_PARENT)
+      return parents;
+
+   if (!(second & LAST_EDGE))
+   {
+      parents.append(static_cast<int>(second));
+      return parents;
+   }
+
+   // Octopus merges keep the second and next parents in the extra edges list. The last one has the high bit set.
+   for (auto edge = second & ~LAST_EDGE; edge < layer->extraEdgesCount; ++edge)
+   {
+      const auto value = readUInt32(layer->extraEdges + edge * 4);
+
+      parents.append(static_cast<int>(value & ~LAST_EDGE));
+
+      if (value & LAST_EDGE)
+         break;
+   }
+
+   return parents;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <ObjectId.h>
+
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The CommitGraphFile class reads the commit-graph file that Git keeps in objects/info. The file has the
+ * parents and the commit date of every commit in binary form, so the topology of the history can be built without
+ * running git log. Both the single file and the chain of split files (objects/info/commit-graphs) are supported.
+ *
+ * The files are memory mapped and nothing is copied: every commit is identified by its position in the graph, the
+ * same Git uses. In a chain the positions of a file start after the commits of its base files.
+ */
+class CommitGraphFile
+{
+public:
+   explicit CommitGraphFile(const QString &objectsDir);
+   ~CommitGraphFile();
+
+   /**
+    * @brief open Maps the commit-graph of the repository.
+    * @return True if the repository has a commit-graph and all its files are valid.
+    */
+   bool open();
+
+   int count() const { return mCount; }
+
+   /**
+    * @brief position Looks for a commit in the graph.
+    * @return The position of the commit or -1 if it isn't in the graph.
+    */
+   int position(const ObjectId &sha) const;
+
+   ObjectId objectId(int position) const;
+   qint64 commitDate(int position) const;
+
+   /**
+    * @brief parents Gets the positions of the parents of a commit, in the same order Git stores them.
+    */
+   QVector<int> parents(int position) const;
+
+private:
+   struct Layer;
+
+   QString mObjectsDir;
+   QVector<QSharedPointer<Layer>> mLayers;
+   int mCount = 0;
+
+   bool openLayer(const QString &path);
+   const Layer *layerOf(int position) const;
+};
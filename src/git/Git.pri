@@ -2,46 +2,68 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/AGitProcess.h \
+    $$PWD/CommitGraphFile.h \
     $$PWD/GitAsyncProcess.h \
     $$PWD/GitBase.h \
     $$PWD/GitBranches.h \
+    $$PWD/GitCatFile.h \
     $$PWD/GitCloneProcess.h \
+    $$PWD/GitCommitBodies.h \
+    $$PWD/GitCommitTexts.h \
     $$PWD/GitConfig.h \
     $$PWD/GitCredentials.h \
     $$PWD/GitExecResult.h \
+    $$PWD/GitFuture.h \
     $$PWD/GitHistory.h \
     $$PWD/GitLocal.h \
+    $$PWD/GitLogParser.h \
+    $$PWD/GitLogStreamProcess.h \
     $$PWD/GitMerge.h \
     $$PWD/GitPatches.h \
     $$PWD/GitRemote.h \
     $$PWD/GitRepoLoader.h \
+    $$PWD/GitRepoState.h \
+    $$PWD/GitRepoWatcher.h \
     $$PWD/GitRequestorProcess.h \
+    $$PWD/GitScheduler.h \
     $$PWD/GitStashes.h \
     $$PWD/GitSubmodules.h \
     $$PWD/GitSubtree.h \
     $$PWD/GitSyncProcess.h \
     $$PWD/GitTags.h \
-    $$PWD/GitWip.h
+    $$PWD/GitWip.h \
+    $$PWD/ReferencesReader.h
 
 SOURCES += \
     $$PWD/AGitProcess.cpp \
+    $$PWD/CommitGraphFile.cpp \
     $$PWD/GitAsyncProcess.cpp \
     $$PWD/GitBase.cpp \
     $$PWD/GitBranches.cpp \
+    $$PWD/GitCatFile.cpp \
     $$PWD/GitCloneProcess.cpp \
+    $$PWD/GitCommitBodies.cpp \
+    $$PWD/GitCommitTexts.cpp \
     $$PWD/GitConfig.cpp \
     $$PWD/GitCredentials.cpp \
     $$PWD/GitExecResult.cpp \
+    $$PWD/GitFuture.cpp \
     $$PWD/GitHistory.cpp \
     $$PWD/GitLocal.cpp \
+    $$PWD/GitLogParser.cpp \
+    $$PWD/GitLogStreamProcess.cpp \
     $$PWD/GitMerge.cpp \
     $$PWD/GitPatches.cpp \
     $$PWD/GitRemote.cpp \
     $$PWD/GitRepoLoader.cpp \
+    $$PWD/GitRepoState.cpp \
+    $$PWD/GitRepoWatcher.cpp \
     $$PWD/GitRequestorProcess.cpp \
+    $$PWD/GitScheduler.cpp \
     $$PWD/GitStashes.cpp \
     $$PWD/GitSubmodules.cpp \
     $$PWD/GitSubtree.cpp \
     $$PWD/GitSyncProcess.cpp \
     $$PWD/GitTags.cpp \
-    $$PWD/GitWip.cpp
+    $$PWD/GitWip.cpp \
+    $$PWD/ReferencesReader.cpp
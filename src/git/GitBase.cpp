@@ -1,6 +1,7 @@
 #include "GitBase.h"
 
 #include <GitAsyncProcess.h>
+#include <GitCatFile.h>
 #include <GitSyncProcess.h>
 
 #include <QLogger.h>
@@ -9,6 +10,18 @@ using namespace QLogger;
 
 #include <QDir>
 #include <QFileInfo>
+#include <QThread>
+
+namespace
+{
+void logResult(const QString &cmd, const GitExecResult &ret)
+{
+   if (ret.success && ret.output.contains("fatal:"))
+      QLog_Info("Git", QString("Git command {%1} reported issues:\n%2").arg(cmd, ret.output));
+   else if (!ret.success)
+      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(cmd, ret.output));
+}
+}
 
 GitBase::GitBase(const QString &workingDirectory)
    : mWorkingDirectory(workingDirectory)
@@ -29,6 +42,23 @@ GitBase::GitBase(const QString &workingDirectory)
    }
 }
 
+GitBase::~GitBase()
+{
+   // The state may live in another thread. It stops using this object right now and it's deleted there.
+   if (mRepoState)
+   {
+      mRepoState->detach();
+      mRepoState->deleteLater();
+   }
+
+   // Every process belongs to its thread, so it's deleted there.
+   for (const auto &catFile : qAsConst(mCatFiles))
+   {
+      if (catFile)
+         catFile->deleteLater();
+   }
+}
+
 QString GitBase::getWorkingDir() const
 {
    return mWorkingDirectory;
@@ -44,51 +74,93 @@ QString GitBase::getGitDir() const
    return mGitDirectory;
 }
 
+QString GitBase::getCommonDir() const
+{
+   // Linked worktrees keep the objects and the shared references in the common directory.
+   if (QFile commonDir(QString("%1/commondir").arg(mGitDirectory)); commonDir.open(QIODevice::ReadOnly))
+      return QDir::cleanPath(QDir(mGitDirectory).absoluteFilePath(QString::fromUtf8(commonDir.readAll().trimmed())));
+
+   return mGitDirectory;
+}
+
 GitExecResult GitBase::run(const QString &cmd) const
 {
-   GitSyncProcess p(mWorkingDirectory);
+   const auto ret = GitScheduler::getInstance()->runSync(mWorkingDirectory, cmd, [this, &cmd]() {
+      GitSyncProcess p(mWorkingDirectory);
 
-   const auto ret = p.run(cmd);
-   const auto runOutput = ret.output;
+      return p.run(cmd);
+   });
 
-   if (ret.success && runOutput.contains("fatal:"))
-      QLog_Info("Git", QString("Git command {%1} reported issues:\n%2").arg(cmd, runOutput));
-   else if (!ret.success)
-      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(cmd, runOutput));
+   logResult(cmd, ret);
 
    return ret;
 }
 
+QFuture<GitExecResult> GitBase::runAsync(const QString &cmd, GitScheduler::Priority priority) const
+{
+   return GitScheduler::getInstance()->run(mWorkingDirectory, cmd, priority);
+}
+
 void GitBase::updateCurrentBranch()
 {
    QLog_Trace("Git", "Updating the cached current branch");
 
-   const auto cmd = QString("git rev-parse --abbrev-ref HEAD");
-
-   QLog_Trace("Git", QString("Updating the cached current branch: {%1}").arg(cmd));
+   repoState()->refresh();
+}
 
-   const auto ret = run(cmd);
+QString GitBase::getCurrentBranch() const
+{
+   return getRepoState()->currentBranch;
+}
 
-   mCurrentBranch = ret.success ? ret.output.trimmed().remove("heads/") : QString();
+std::shared_ptr<const RepoState> GitBase::getRepoState() const
+{
+   return repoState()->state();
 }
 
-QString GitBase::getCurrentBranch()
+GitRepoState *GitBase::repoState() const
 {
-   if (mCurrentBranch.isEmpty())
-      updateCurrentBranch();
+   QMutexLocker lock(&mRepoStateMutex);
+
+   // Most of the GitBase objects are short-lived and never need the state, so its watcher is only created on demand.
+   if (!mRepoState)
+      mRepoState = new GitRepoState(this);
 
-   return mCurrentBranch;
+   return mRepoState;
 }
 
 GitExecResult GitBase::getLastCommit() const
 {
    QLog_Trace("Git", "Getting last commit");
 
-   const auto cmd = QString("git rev-parse HEAD");
+   return resolve("HEAD");
+}
 
-   QLog_Trace("Git", QString("Getting last commit: {%1}").arg(cmd));
+GitCatFile *GitBase::catFile() const
+{
+   const auto thread = QThread::currentThread();
 
-   const auto ret = run(cmd);
+   QMutexLocker lock(&mCatFilesMutex);
 
-   return ret;
+   auto &catFile = mCatFiles[thread];
+
+   if (!catFile)
+   {
+      catFile = new GitCatFile(mWorkingDirectory);
+
+      // The deferred deletions are processed when the thread finishes.
+      QObject::connect(thread, &QThread::finished, catFile, &QObject::deleteLater, Qt::DirectConnection);
+   }
+
+   return catFile;
+}
+
+GitExecResult GitBase::resolve(const QString &revision) const
+{
+   const auto object = catFile()->info(revision);
+
+   if (!object.isValid())
+      return { false, QString("The revision {%1} couldn't be resolved.").arg(revision) };
+
+   return { true, object.sha };
 }
@@ -24,28 +24,86 @@
  ***************************************************************************************/
 
 #include <GitExecResult.h>
+#include <GitRepoState.h>
+#include <GitScheduler.h>
+
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QPointer>
+
+class GitCatFile;
+class QThread;
 
 class GitBase final
 {
 public:
    explicit GitBase(const QString &workingDirectory);
+   ~GitBase();
 
    GitExecResult run(const QString &cmd) const;
 
+   /**
+    * @brief runAsync Runs a git command without blocking the calling thread, that needs an event loop. The command is
+    * queued in the GitScheduler and the future finishes when the command does. Canceling it removes the command from
+    * the queue or kills it.
+    *
+    * @param cmd The git command.
+    * @param priority The priority class of the command.
+    * @return The future with the result of the command.
+    */
+   QFuture<GitExecResult> runAsync(const QString &cmd,
+                                   GitScheduler::Priority priority = GitScheduler::Priority::Interactive) const;
+
    QString getWorkingDir() const;
 
    void setWorkingDir(const QString &workingDir);
 
    QString getGitDir() const;
 
+   QString getCommonDir() const;
+
+   /**
+    * @brief updateCurrentBranch Reads the state of the repository again after GitQlient changes it.
+    */
    void updateCurrentBranch();
 
-   QString getCurrentBranch();
+   QString getCurrentBranch() const;
+
+   /**
+    * @brief getRepoState Returns the last snapshot of HEAD, the current branch, its upstream and the operation in
+    * progress. It doesn't run git, so it's the one to use while painting.
+    */
+   std::shared_ptr<const RepoState> getRepoState() const;
 
+   /**
+    * @brief getLastCommit Looks up the commit of HEAD right now. It's meant for the code that has just changed it.
+    */
    GitExecResult getLastCommit() const;
 
+   /**
+    * @brief catFile Returns the git cat-file processes of the calling thread, that look up objects and revisions
+    * without spawning git for every request. They are created on the first call of every thread.
+    */
+   GitCatFile *catFile() const;
+
+   /**
+    * @brief resolve Resolves a revision into the SHA of the object it points to.
+    *
+    * @param revision A reference, a SHA or any other revision like <tag>^{commit}.
+    * @return The SHA if the revision exists, otherwise the error.
+    */
+   GitExecResult resolve(const QString &revision) const;
+
 protected:
    QString mWorkingDirectory;
    QString mGitDirectory;
-   QString mCurrentBranch;
+
+private:
+   mutable QMutex mRepoStateMutex;
+   mutable GitRepoState *mRepoState = nullptr;
+   mutable QMutex mCatFilesMutex;
+   mutable QHash<QThread *, QPointer<GitCatFile>> mCatFiles;
+
+   GitRepoState *repoState() const;
 };
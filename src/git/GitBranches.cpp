@@ -173,16 +173,7 @@ GitExecResult GitBranches::getLastCommitOfBranch(const QString &branch)
 {
    QLog_Debug("Git", QString("Getting last commit of a branch: {%1}").arg(branch));
 
-   const auto cmd = QString("git rev-parse %1").arg(branch);
-
-   QLog_Trace("Git", QString("Getting last commit of a branch: {%1}").arg(cmd));
-
-   auto ret = mGitBase->run(cmd);
-
-   if (ret.success)
-      ret.output = ret.output.trimmed();
-
-   return ret;
+   return mGitBase->resolve(branch);
 }
 
 GitExecResult GitBranches::pushUpstream(const QString &branchName)
@@ -198,6 +189,13 @@ GitExecResult GitBranches::pushUpstream(const QString &branchName)
    return ret;
 }
 
+QFuture<GitExecResult> GitBranches::pushUpstreamAsync(const QString &branchName)
+{
+   QLog_Debug("Git", QString("Pushing upstream asynchronously: {%1}").arg(branchName));
+
+   return mGitBase->runAsync(QString("git push --set-upstream origin %1").arg(branchName));
+}
+
 GitExecResult GitBranches::rebaseOnto(const QString &currentBranch, const QString &startBranch,
                                       const QString &fromBranch) const
 {
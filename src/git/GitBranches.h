@@ -25,6 +25,7 @@
 
 #include <GitExecResult.h>
 
+#include <QFuture>
 #include <QSharedPointer>
 
 class GitBase;
@@ -44,6 +45,7 @@ public:
    GitExecResult removeRemoteBranch(const QString &branchName);
    GitExecResult getLastCommitOfBranch(const QString &branch);
    GitExecResult pushUpstream(const QString &branchName);
+   QFuture<GitExecResult> pushUpstreamAsync(const QString &branchName);
    GitExecResult rebaseOnto(const QString &currentBranch, const QString &startBranch, const QString &fromBranch) const;
 
 private:
@@ -0,0 +1,233 @@
+#include "GitCatFile.h"
+
+#include <GitQlientSettings.h>
+#include <Tracer.h>
+
+#include <QProcess>
+#include <QTimer>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+// Time to wait for an answer before the process is considered stuck.
+static const int READ_TIMEOUT_MS = 10000;
+
+GitCatFile::GitCatFile(const QString &workingDirectory, QObject *parent)
+   : QObject(parent)
+   , mWorkingDirectory(workingDirectory)
+{
+   mContents.withContent = true;
+
+   for (const auto batch : { &mContents, &mInfo })
+   {
+      batch->process = new QProcess(this);
+      batch->process->setWorkingDirectory(mWorkingDirectory);
+      batch->process->setStandardErrorFile(QProcess::nullDevice());
+
+      connect(batch->process, &QProcess::readyReadStandardOutput, this, [this, batch]() { readAnswers(*batch); });
+      connect(batch->process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+              [this, batch]() {
+                 if (!batch->pending.isEmpty())
+                 {
+                    QLog_Warning("Git", QString("git cat-file finished with {%1} requests pending.")
+                                            .arg(batch->pending.count()));
+                    failPending(*batch);
+                 }
+              });
+   }
+}
+
+GitCatFile::~GitCatFile()
+{
+   for (const auto batch : { &mContents, &mInfo })
+   {
+      batch->process->disconnect(this);
+
+      // Closing the input is enough for git cat-file to exit.
+      if (batch->process->state() == QProcess::Running)
+      {
+         batch->process->closeWriteChannel();
+
+         if (!batch->process->waitForFinished(1000))
+            batch->process->kill();
+      }
+   }
+}
+
+GitObject GitCatFile::info(const QString &object)
+{
+   return read(mInfo, { object }).constFirst();
+}
+
+QVector<GitObject> GitCatFile::contents(const QStringList &objects)
+{
+   return read(mContents, objects);
+}
+
+quint64 GitCatFile::request(const QString &object, bool withContent)
+{
+   auto &batch = withContent ? mContents : mInfo;
+   const auto id = ++mLastRequestId;
+
+   if (ensureStarted(batch))
+   {
+      batch.pending.enqueue({ id, nullptr, nullptr });
+      write(batch, { object });
+   }
+   else
+      QTimer::singleShot(0, this, [this, id]() { emit objectReceived(id, GitObject()); });
+
+   return id;
+}
+
+bool GitCatFile::ensureStarted(Batch &batch)
+{
+   if (batch.process->state() == QProcess::Running)
+      return true;
+
+   batch.buffer.clear();
+   batch.offset = 0;
+
+   const auto gitAlternative = GitQlientSettings().globalValue("gitLocation", "").toString();
+   const auto mode = batch.withContent ? QString("--batch") : QString("--batch-check");
+
+   QLog_Debug("Git", QString("Starting git cat-file %1 in {%2}.").arg(mode, mWorkingDirectory));
+
+   batch.process->start(gitAlternative.isEmpty() ? QString("git") : gitAlternative, { QString("cat-file"), mode });
+
+   const auto started = batch.process->waitForStarted();
+
+   if (!started)
+      QLog_Warning("Git", QString("Unable to start git cat-file: %1").arg(batch.process->errorString()));
+
+   return started;
+}
+
+QVector<GitObject> GitCatFile::read(Batch &batch, const QStringList &objects)
+{
+   TraceSpan span("Git", "Cat-file");
+   span.setArgs(QString::number(objects.count()));
+
+   QVector<GitObject> results(objects.count());
+
+   if (objects.isEmpty() || !ensureStarted(batch))
+      return results;
+
+   // Every request knows where its answer goes, so the answers of other requests read meanwhile are dispatched too.
+   auto remaining = objects.count();
+
+   for (auto &object : results)
+      batch.pending.enqueue({ 0, &object, &remaining });
+
+   write(batch, objects);
+
+   while (remaining > 0)
+   {
+      readAnswers(batch);
+
+      if (remaining > 0 && !batch.process->waitForReadyRead(READ_TIMEOUT_MS))
+      {
+         QLog_Warning("Git", QString("git cat-file didn't answer: %1").arg(batch.process->errorString()));
+
+         // The answers would be out of sync from now on: the process starts again in the next request.
+         batch.process->kill();
+         batch.process->waitForFinished();
+         failPending(batch);
+      }
+   }
+
+   return results;
+}
+
+void GitCatFile::write(Batch &batch, const QStringList &objects)
+{
+   QByteArray input;
+
+   // A line break would split the request in two and the answers wouldn't match the requests.
+   for (const auto &object : objects)
+      input.append(object.section(QLatin1Char('\n'), 0, 0).toUtf8()).append('\n');
+
+   batch.process->write(input);
+}
+
+void GitCatFile::readAnswers(Batch &batch)
+{
+   batch.buffer.append(batch.process->readAllStandardOutput());
+
+   GitObject object;
+
+   while (!batch.pending.isEmpty() && parseAnswer(batch, object))
+   {
+      const auto request = batch.pending.dequeue();
+
+      if (request.object)
+      {
+         *request.object = std::move(object);
+         --*request.remaining;
+      }
+      else
+         emit objectReceived(request.id, object);
+
+      object = GitObject();
+   }
+
+   batch.buffer.remove(0, batch.offset);
+   batch.offset = 0;
+}
+
+bool GitCatFile::parseAnswer(Batch &batch, GitObject &object)
+{
+   const auto &buffer = batch.buffer;
+   const auto headerEnd = buffer.indexOf('\n', batch.offset);
+
+   if (headerEnd == -1)
+      return false;
+
+   // The header is "<sha> <type> <size>", or "<object> missing" when the object doesn't exist.
+   const auto header = buffer.mid(batch.offset, headerEnd - batch.offset);
+   const auto sizeStart = header.lastIndexOf(' ');
+   const auto typeStart = sizeStart > 0 ? header.lastIndexOf(' ', sizeStart - 1) : -1;
+   auto validSize = false;
+   const auto size = header.mid(sizeStart + 1).toLongLong(&validSize);
+
+   if (!validSize || typeStart <= 0)
+   {
+      batch.offset = headerEnd + 1;
+      return true;
+   }
+
+   if (batch.withContent)
+   {
+      // The content is followed by a line break.
+      if (buffer.size() < headerEnd + 1 + size + 1)
+         return false;
+
+      object.content = buffer.mid(headerEnd + 1, static_cast<int>(size));
+      batch.offset = headerEnd + 1 + static_cast<int>(size) + 1;
+   }
+   else
+      batch.offset = headerEnd + 1;
+
+   object.sha = QString::fromLatin1(header.left(typeStart));
+   object.type = header.mid(typeStart + 1, sizeStart - typeStart - 1);
+   object.size = size;
+
+   return true;
+}
+
+void GitCatFile::failPending(Batch &batch)
+{
+   while (!batch.pending.isEmpty())
+   {
+      const auto request = batch.pending.dequeue();
+
+      if (request.object)
+         --*request.remaining;
+      else
+         emit objectReceived(request.id, GitObject());
+   }
+
+   batch.buffer.clear();
+   batch.offset = 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QByteArray>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QProcess;
+
+/**
+ * @brief The GitObject struct is the answer of git cat-file for one object: its SHA, type and size, and the raw
+ * content when it was requested.
+ */
+struct GitObject
+{
+   QString sha;
+   QByteArray type;
+   qint64 size = -1;
+   QByteArray content;
+
+   bool isValid() const { return size >= 0; }
+};
+
+/**
+ * @brief The GitCatFile class keeps git cat-file --batch and --batch-check running for a repository, so the objects
+ * and the revisions are looked up without spawning a git process each time. The requests are written to the
+ * processes in one go and the answers are read in the same order.
+ *
+ * The processes are started on the first request and started again if they die. Since they belong to the thread that
+ * creates the object, GitBase keeps one GitCatFile per thread.
+ */
+class GitCatFile : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief objectReceived Signal triggered when the answer of an asynchronous request is read.
+    *
+    * @param requestId The id returned by request().
+    * @param object The object. It's not valid if it doesn't exist.
+    */
+   void objectReceived(quint64 requestId, const GitObject &object);
+
+public:
+   explicit GitCatFile(const QString &workingDirectory, QObject *parent = nullptr);
+   ~GitCatFile() override;
+
+   /**
+    * @brief info Returns the SHA, type and size of an object without its content.
+    * @param object Any revision git understands, like a reference, a SHA or <sha>:<path>.
+    */
+   GitObject info(const QString &object);
+
+   /**
+    * @brief contents Returns the objects with their content. They are requested in one go and the result is in the
+    * same order as @p objects.
+    */
+   QVector<GitObject> contents(const QStringList &objects);
+
+   /**
+    * @brief request Requests an object asynchronously. The answer is sent through objectReceived().
+    *
+    * @param object The object to look up.
+    * @param withContent True if the content is needed.
+    * @return The id of the request.
+    */
+   quint64 request(const QString &object, bool withContent = true);
+
+private:
+   struct Request
+   {
+      quint64 id;
+      GitObject *object;
+      int *remaining;
+   };
+
+   struct Batch
+   {
+      QProcess *process = nullptr;
+      bool withContent = false;
+      QByteArray buffer;
+      int offset = 0;
+      QQueue<Request> pending;
+   };
+
+   QString mWorkingDirectory;
+   Batch mContents;
+   Batch mInfo;
+   quint64 mLastRequestId = 0;
+
+   bool ensureStarted(Batch &batch);
+   QVector<GitObject> read(Batch &batch, const QStringList &objects);
+   void write(Batch &batch, const QStringList &objects);
+   void readAnswers(Batch &batch);
+   bool parseAnswer(Batch &batch, GitObject &object);
+   void failPending(Batch &batch);
+};
+
+Q_DECLARE_METATYPE(GitObject)
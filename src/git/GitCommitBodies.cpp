@@ -0,0 +1,101 @@
+#include "GitCommitBodies.h"
+
+#include <CommitInfo.h>
+#include <GitBase.h>
+#include <GitCache.h>
+#include <GitCatFile.h>
+
+#include <QTextCodec>
+
+#include <QLogger.h>
+
+#include <algorithm>
+
+using namespace QLogger;
+
+// Number of commits after the selected one whose bodies are requested in the same batch.
+static const int BODIES_BATCH_SIZE = 50;
+
+GitCommitBodies::GitCommitBodies(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
+   : mGit(git)
+   , mCache(cache)
+{
+}
+
+bool GitCommitBodies::load(const QString &sha) const
+{
+   if (sha.isEmpty() || sha == CommitInfo::ZERO_SHA || mCache->hasCommitBody(sha))
+      return true;
+
+   const auto commit = mCache->commitInfo(sha);
+
+   if (!commit.isValid())
+      return false;
+
+   QStringList shas { commit.sha };
+   const auto lastRow = std::min(static_cast<int>(commit.pos) + BODIES_BATCH_SIZE, mCache->commitCount() - 1);
+
+   for (auto row = static_cast<int>(commit.pos) + 1; row <= lastRow; ++row)
+   {
+      if (const auto rowSha = mCache->commitInfo(row).sha; !rowSha.isEmpty() && !mCache->hasCommitBody(rowSha))
+         shas.append(rowSha);
+   }
+
+   return request(shas) && mCache->hasCommitBody(commit.sha);
+}
+
+bool GitCommitBodies::request(const QStringList &shas) const
+{
+   QLog_Debug("Git", QString("Loading the bodies of {%1} commits.").arg(shas.count()));
+
+   const auto objects = mGit->catFile()->contents(shas);
+   auto loaded = false;
+
+   for (auto i = 0; i < objects.count(); ++i)
+   {
+      const auto &object = objects.at(i);
+
+      if (!object.isValid() || object.type != "commit")
+      {
+         QLog_Error("Git", QString("The body of the commit {%1} couldn't be loaded.").arg(shas.at(i)));
+         continue;
+      }
+
+      mCache->insertCommitBody(shas.at(i), body(object.content));
+      loaded = true;
+   }
+
+   return loaded;
+}
+
+QString GitCommitBodies::body(const QByteArray &commit)
+{
+   // The raw commit is the headers, an empty line and the message. The body is the message without the subject,
+   // that is its first paragraph.
+   const auto headersEnd = commit.indexOf("\n\n");
+
+   if (headersEnd == -1)
+      return QString();
+
+   const auto message = commit.mid(headersEnd + 2);
+   const auto subjectEnd = message.indexOf("\n\n");
+
+   if (subjectEnd == -1)
+      return QString();
+
+   const auto body = message.mid(subjectEnd + 2).trimmed();
+   const auto headers = commit.left(headersEnd + 1);
+   const auto encodingStart = headers.indexOf("\nencoding ");
+
+   // git log shows the messages in UTF-8, so the ones stored with another encoding are converted.
+   if (encodingStart != -1)
+   {
+      const auto nameStart = encodingStart + 10;
+      const auto name = headers.mid(nameStart, headers.indexOf('\n', nameStart) - nameStart);
+
+      if (const auto codec = QTextCodec::codecForName(name); codec && name.toLower() != "utf-8")
+         return codec->toUnicode(body);
+   }
+
+   return QString::fromUtf8(body);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QSharedPointer>
+#include <QStringList>
+
+class GitBase;
+class GitCache;
+
+/**
+ * @brief The GitCommitBodies class loads the commit bodies on demand when the history is loaded without them. The
+ * bodies are read in batches from git cat-file and stored in the cache.
+ */
+class GitCommitBodies
+{
+public:
+   explicit GitCommitBodies(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache);
+
+   /**
+    * @brief load Loads the body of the commit @p sha together with the bodies of the commits that follow it in the
+    * history, since they are the most likely to be selected next. Only the bodies missing in the cache are requested.
+    *
+    * @param sha The SHA of the commit.
+    * @return True if the body of the commit is available in the cache.
+    */
+   bool load(const QString &sha) const;
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitCache> mCache;
+
+   bool request(const QStringList &shas) const;
+   static QString body(const QByteArray &commit);
+};
@@ -0,0 +1,118 @@
+#include "GitCommitTexts.h"
+
+#include <GitBase.h>
+#include <GitCache.h>
+#include <GitLogParser.h>
+#include <GitLogStreamProcess.h>
+#include <GitRequestorProcess.h>
+
+#include <QLogger.h>
+
+#include <algorithm>
+
+using namespace QLogger;
+
+// Number of rows whose texts are requested in the same batch. A quarter of them are above the requested row.
+static const int TEXTS_BATCH_SIZE = 200;
+
+namespace
+{
+QString textsCommand(const QString &revisions)
+{
+   // The bodies are loaded as well: they are cheap compared to spawning git again.
+   return QString("git log --no-show-signature --no-color --log-size --parents -z --pretty=format:%1 %2")
+       .arg(QString::fromUtf8(GitLogParser::LOG_FORMAT), revisions);
+}
+}
+
+GitCommitTexts::GitCommitTexts(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                               QObject *parent)
+   : QObject(parent)
+   , mGit(git)
+   , mCache(cache)
+{
+}
+
+void GitCommitTexts::load(int row)
+{
+   if (mLoadingAll || mCache->hasCommitText(row))
+      return;
+
+   auto shas = mCache->missingCommitTexts(row - TEXTS_BATCH_SIZE / 4, TEXTS_BATCH_SIZE);
+
+   shas.erase(std::remove_if(shas.begin(), shas.end(),
+                             [this](const QString &sha) { return mPending.contains(sha) || mFailed.contains(sha); }),
+              shas.end());
+
+   if (shas.isEmpty())
+      return;
+
+   QLog_Debug("Git", QString("Loading the texts of {%1} commits.").arg(shas.count()));
+
+   for (const auto &sha : qAsConst(shas))
+      mPending.insert(sha);
+
+   const auto requestor = new GitRequestorProcess(mGit->getWorkingDir());
+   connect(requestor, &GitRequestorProcess::procDataReady, this,
+           [this, shas](const QByteArray &log) { insertTexts(shas, GitLogParser::parseUnsignedLog(log)); });
+
+   // A canceled process finishes without data, its commits can be requested again.
+   connect(requestor, &QObject::destroyed, this, [this, shas]() {
+      for (const auto &sha : shas)
+         mPending.remove(sha);
+   });
+
+   if (!requestor->run(textsCommand(QString("--no-walk=unsorted %1").arg(shas.join(QLatin1Char(' '))))).success)
+   {
+      insertTexts(shas, {});
+      requestor->deleteLater();
+   }
+}
+
+void GitCommitTexts::loadAll(const QString &revisions)
+{
+   if (mLoadingAll)
+      return;
+
+   if (revisions.isEmpty() || !mCache->hasMissingCommitTexts())
+   {
+      emit signalAllTextsLoaded();
+      return;
+   }
+
+   QLog_Debug("Git", "Loading the texts of all the commits.");
+
+   mLoadingAll = true;
+
+   const auto requestor = new GitLogStreamProcess(mGit->getWorkingDir());
+   connect(requestor, &GitLogStreamProcess::signalRecordsReady, this,
+           [this](const QByteArray &records) { mCache->insertCommitTexts(GitLogParser::parseUnsignedLog(records)); });
+   connect(requestor, &QObject::destroyed, this, [this]() {
+      mLoadingAll = false;
+
+      emit signalAllTextsLoaded();
+   });
+
+   if (!requestor->run(textsCommand(revisions)).success)
+      requestor->deleteLater();
+}
+
+void GitCommitTexts::insertTexts(const QStringList &shas, const QVector<CommitInfo> &commits)
+{
+   mCache->insertCommitTexts(commits);
+
+   // The commits git didn't return are not requested again, otherwise every repaint of their rows would run git.
+   QSet<QString> loaded;
+
+   for (const auto &commit : commits)
+      loaded.insert(commit.sha);
+
+   for (const auto &sha : shas)
+   {
+      if (!loaded.contains(sha))
+         mFailed.insert(sha);
+   }
+
+   if (loaded.count() != shas.count())
+      QLog_Error("Git", QString("The texts of {%1} commits couldn't be loaded.").arg(shas.count() - loaded.count()));
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVector>
+
+class GitBase;
+class GitCache;
+class CommitInfo;
+
+/**
+ * @brief The GitCommitTexts class loads the message and the identities of the commits whose topology was read from
+ * the commit-graph. It lives in the loader thread and runs git asynchronously: the rows that are shown request their
+ * texts in batches, and a search requests all of them at once.
+ */
+class GitCommitTexts : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief signalAllTextsLoaded Signal triggered when the request started by loadAll finishes, even if it failed.
+    */
+   void signalAllTextsLoaded();
+
+public:
+   explicit GitCommitTexts(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache,
+                           QObject *parent = nullptr);
+
+   /**
+    * @brief load Requests the texts of the commit in @p row together with the ones of the rows around it, since they
+    * are the most likely to be shown next. Only the texts missing in the cache, not requested yet and not failed
+    * before are requested.
+    *
+    * @param row The row of the commit in the history.
+    */
+   void load(int row);
+
+   /**
+    * @brief loadAll Requests the texts of all the commits reachable from @p revisions in a single git log.
+    *
+    * @param revisions The tips of the history, separated by spaces.
+    */
+   void loadAll(const QString &revisions);
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QSharedPointer<GitCache> mCache;
+   QSet<QString> mPending;
+   QSet<QString> mFailed;
+   bool mLoadingAll = false;
+
+   void insertTexts(const QStringList &shas, const QVector<CommitInfo> &commits);
+};
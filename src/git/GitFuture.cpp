@@ -0,0 +1,68 @@
+#include "GitFuture.h"
+
+#include <QFutureInterface>
+#include <QSharedPointer>
+
+namespace GitFuture
+{
+QFuture<GitExecResult> andThen(const QFuture<GitExecResult> &future,
+                               std::function<QFuture<GitExecResult>(const GitExecResult &)> next)
+{
+   QFutureInterface<GitExecResult> promise;
+   promise.reportStarted();
+
+   // The watcher of the chain owns the continuations and cancels the command that is running.
+   const auto current = QSharedPointer<QFuture<GitExecResult>>::create(future);
+   const auto chain = new QFutureWatcher<GitExecResult>();
+
+   QObject::connect(chain, &QFutureWatcherBase::canceled, chain, [current]() { current->cancel(); });
+   QObject::connect(chain, &QFutureWatcherBase::finished, chain, &QObject::deleteLater);
+
+   const auto finish = [promise](const QFuture<GitExecResult> &step) mutable {
+      if (step.isCanceled() || step.resultCount() == 0)
+         promise.reportCanceled();
+      else
+         promise.reportResult(step.result());
+
+      promise.reportFinished();
+   };
+
+   const auto first = new QFutureWatcher<GitExecResult>(chain);
+
+   QObject::connect(first, &QFutureWatcherBase::finished, chain, [first, current, next, finish, chain]() mutable {
+      first->deleteLater();
+
+      if (first->isCanceled() || first->future().resultCount() == 0 || !first->result().success)
+      {
+         finish(first->future());
+         return;
+      }
+
+      *current = next(first->result());
+
+      const auto second = new QFutureWatcher<GitExecResult>(chain);
+
+      QObject::connect(second, &QFutureWatcherBase::finished, chain, [second, finish]() mutable {
+         second->deleteLater();
+         finish(second->future());
+      });
+
+      second->setFuture(*current);
+   });
+
+   first->setFuture(future);
+   chain->setFuture(promise.future());
+
+   return promise.future();
+}
+
+QFuture<GitExecResult> finished(const GitExecResult &result)
+{
+   QFutureInterface<GitExecResult> promise;
+   promise.reportStarted();
+   promise.reportResult(result);
+   promise.reportFinished();
+
+   return promise.future();
+}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitExecResult.h>
+
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <functional>
+
+/**
+ * @brief The GitFuture namespace has the helpers to consume the futures of the asynchronous git commands.
+ *
+ * A command started with GitBase::runAsync() returns a QFuture right away. The result is received in a continuation
+ * that runs in the thread of a context object, usually the widget that started it, and canceling the future stops the
+ * command.
+ */
+namespace GitFuture
+{
+/**
+ * @brief then Calls @p callback with the result of @p future in the thread of @p context once it finishes. It's not
+ * called if the future is canceled or if @p context is destroyed before.
+ *
+ * @param future The future of the command.
+ * @param context The object that owns the continuation.
+ * @param callback The continuation. It receives the result.
+ */
+template <typename T, typename Callback>
+void then(const QFuture<T> &future, QObject *context, Callback callback)
+{
+   const auto watcher = new QFutureWatcher<T>(context);
+
+   QObject::connect(watcher, &QFutureWatcherBase::finished, context,
+                    [watcher, callback = std::move(callback)]() mutable {
+                       watcher->deleteLater();
+
+                       if (!watcher->isCanceled() && watcher->future().resultCount() > 0)
+                          callback(watcher->result());
+                    });
+
+   watcher->setFuture(future);
+}
+
+/**
+ * @brief andThen Chains a command after @p future when it succeeds. The result of the chain is the result of the last
+ * command that ran, and canceling it cancels the command that is running.
+ *
+ * @param future The future of the first command.
+ * @param next Starts the next command from the result of the first one.
+ * @return The future of the chain.
+ */
+QFuture<GitExecResult> andThen(const QFuture<GitExecResult> &future,
+                               std::function<QFuture<GitExecResult>(const GitExecResult &)> next);
+
+/**
+ * @brief finished Returns a future that is already finished with @p result.
+ */
+QFuture<GitExecResult> finished(const GitExecResult &result);
+}
@@ -44,6 +44,14 @@ GitExecResult GitHistory::history(const QString &file)
    return ret;
 }
 
+QFuture<GitExecResult> GitHistory::historyAsync(const QString &file)
+{
+   QLog_Debug("Git", QString("Executing history asynchronously: {%1}").arg(file));
+
+   // Following the renames walks the whole history, so it's not run in the UI thread.
+   return mGitBase->runAsync(QString("git log --follow --pretty=%H %1").arg(file), GitScheduler::Priority::Visible);
+}
+
 GitExecResult GitHistory::getBranchesDiff(const QString &base, const QString &head)
 {
    QLog_Debug("Git", QString("Getting diff between branches: {%1} and {%2}").arg(base, head));
@@ -25,6 +25,7 @@
 
 #include <GitExecResult.h>
 
+#include <QFuture>
 #include <QSharedPointer>
 
 class GitBase;
@@ -36,6 +37,7 @@ public:
 
    GitExecResult blame(const QString &file, const QString &commitFrom);
    GitExecResult history(const QString &file);
+   QFuture<GitExecResult> historyAsync(const QString &file);
    GitExecResult getBranchesDiff(const QString &base, const QString &head);
    GitExecResult getCommitDiff(const QString &sha, const QString &diffToSha);
    GitExecResult getFileDiff(const QString &currentSha, const QString &previousSha, const QString &file, bool isCached);
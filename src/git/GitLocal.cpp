@@ -7,6 +7,7 @@
 
 #include <QFile>
 #include <QProcess>
+#include <QSet>
 
 using namespace QLogger;
 
@@ -195,17 +196,6 @@ GitExecResult GitLocal::ammend(const QString &msg) const
 GitExecResult GitLocal::commitFiles(QStringList &selFiles, const RevisionFiles &allCommitFiles,
                                     const QString &msg) const
 {
-   QStringList notSel;
-
-   for (auto i = 0; i < allCommitFiles.count(); ++i)
-   {
-      if (const auto &fp = allCommitFiles.getFile(i);
-          selFiles.indexOf(fp) == -1 && allCommitFiles.statusCmp(i, RevisionFiles::IN_INDEX))
-      {
-         notSel.append(fp);
-      }
-   }
-
    if (const auto updIdx = updateIndex(allCommitFiles, selFiles); !updIdx.success)
       return updIdx;
 
@@ -226,12 +216,16 @@ GitExecResult GitLocal::commitFiles(QStringList &selFiles, const RevisionFiles &
 GitExecResult GitLocal::ammendCommit(const QStringList &selFiles, const RevisionFiles &allCommitFiles,
                                      const QString &msg, const QString &author) const
 {
+   QSet<QString> selected;
    QStringList notSel;
 
+   for (const auto &file : selFiles)
+      selected.insert(file);
+
    for (auto i = 0; i < allCommitFiles.count(); ++i)
    {
       const QString &fp = allCommitFiles.getFile(i);
-      if (selFiles.indexOf(fp) == -1 && allCommitFiles.statusCmp(i, RevisionFiles::IN_INDEX)
+      if (!selected.contains(fp) && allCommitFiles.statusCmp(i, RevisionFiles::IN_INDEX)
           && !allCommitFiles.statusCmp(i, RevisionFiles::DELETED))
          notSel.append(fp);
    }
@@ -258,7 +252,7 @@ GitExecResult GitLocal::updateIndex(const RevisionFiles &files, const QStringLis
 
    for (const auto &file : selFiles)
    {
-      const auto index = files.mFiles.indexOf(file);
+      const auto index = files.indexOf(file);
 
       if (index != -1 && files.statusCmp(index, RevisionFiles::DELETED))
          toRemove << file;
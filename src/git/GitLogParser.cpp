@@ -0,0 +1,203 @@
+#include "GitLogParser.h"
+
+#include <Tracer.h>
+
+#include <QThread>
+#include <QtConcurrent>
+
+#include <cstring>
+
+namespace
+{
+// Below this size the log is parsed in the calling thread: the thread pool overhead is not worth it.
+const int PARALLEL_PARSING_THRESHOLD = 1024 * 1024;
+// Every thread gets several chunks so the pool can balance chunks that take longer (i.e. long messages).
+const int CHUNKS_PER_THREAD = 4;
+
+struct LogChunk
+{
+   const char *begin = nullptr;
+   const char *end = nullptr;
+};
+
+QVector<CommitInfo> parseChunk(const LogChunk &chunk)
+{
+   QVector<CommitInfo> commits;
+   commits.reserve(static_cast<int>((chunk.end - chunk.begin) / 256));
+
+   auto cursor = chunk.begin;
+
+   while (cursor < chunk.end)
+   {
+      auto recordEnd
+          = static_cast<const char *>(std::memchr(cursor, '\0', static_cast<size_t>(chunk.end - cursor)));
+
+      if (!recordEnd)
+         recordEnd = chunk.end;
+
+      if (auto commit = CommitInfo { cursor, static_cast<int>(recordEnd - cursor) }; commit.isValid())
+         commits.append(std::move(commit));
+
+      cursor = recordEnd + 1;
+   }
+
+   return commits;
+}
+
+QVector<LogChunk> splitInChunks(const QByteArray &log, int chunks)
+{
+   QVector<LogChunk> ranges;
+   ranges.reserve(chunks);
+
+   auto cursor = log.constData();
+   const auto end = cursor + log.size();
+   const auto chunkSize = log.size() / chunks + 1;
+
+   // Every chunk ends on a record boundary so no record is split between two chunks.
+   while (cursor < end)
+   {
+      auto chunkEnd = end - cursor > chunkSize ? cursor + chunkSize : end;
+
+      if (chunkEnd != end)
+      {
+         const auto separator
+             = static_cast<const char *>(std::memchr(chunkEnd, '\0', static_cast<size_t>(end - chunkEnd)));
+         chunkEnd = separator ? separator : end;
+      }
+
+      ranges.append({ cursor, chunkEnd });
+      cursor = chunkEnd + 1;
+   }
+
+   return ranges;
+}
+}
+
+namespace GitLogParser
+{
+QVector<CommitInfo> parseUnsignedLog(const QByteArray &log)
+{
+   TRACE_SPAN("Git", "Parse log");
+
+   const auto threads = QThread::idealThreadCount();
+   QVector<CommitInfo> commits;
+
+   if (log.size() < PARALLEL_PARSING_THRESHOLD || threads < 2)
+      commits = parseChunk({ log.constData(), log.constData() + log.size() });
+   else
+   {
+      const auto chunks = splitInChunks(log, threads * CHUNKS_PER_THREAD);
+      auto results = QtConcurrent::blockingMapped<QVector<QVector<CommitInfo>>>(chunks, parseChunk);
+
+      auto total = 0;
+      for (const auto &result : qAsConst(results))
+         total += result.count();
+
+      commits.reserve(total);
+
+      for (auto &result : results)
+      {
+         for (auto &commit : result)
+            commits.append(std::move(commit));
+
+         result.clear();
+         result.squeeze();
+      }
+   }
+
+   auto pos = 0;
+   for (auto &commit : commits)
+      commit.pos = ++pos;
+
+   commits.squeeze();
+
+   return commits;
+}
+
+QVector<CommitInfo> parseSignedLog(QByteArray &log)
+{
+   TRACE_SPAN("Git", "Parse signed log");
+
+   log.replace('\000', '\n');
+
+   QVector<CommitInfo> commits;
+
+   const auto data = log.constData();
+   QByteArray gpg;
+   QString gpgKey;
+   auto processingCommit = false;
+   auto pos = 1;
+   auto start = 0;
+   auto commitStart = -1;
+   auto commitEnd = -1;
+   int end;
+   bool goodSignature = false;
+
+   // The lines of a commit are always contiguous: they go from the "log size" line to the next GPG or "log size" one.
+   const auto flushCommit = [&]() {
+      if (commitStart != -1 && commitEnd > commitStart)
+      {
+         if (auto revision = CommitInfo { data + commitStart, commitEnd - commitStart, gpgKey, goodSignature };
+             revision.isValid())
+         {
+            revision.pos = pos++;
+            commits.append(std::move(revision));
+
+            gpgKey.clear();
+         }
+      }
+
+      commitStart = commitEnd = -1;
+   };
+
+   while ((end = log.indexOf('\n', start)) != -1)
+   {
+      const auto lineStart = start;
+      const auto lineLength = end - start;
+      start = end + 1;
+
+      if (lineLength >= 5 && std::memcmp(data + lineStart, "gpg: ", 5) == 0)
+      {
+         const auto line = QByteArray::fromRawData(data + lineStart, lineLength);
+
+         processingCommit = false;
+         gpg.append(line);
+
+         if (line.contains("using RSA key"))
+         {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            gpgKey = QString::fromUtf8(line).split("using RSA key", Qt::SkipEmptyParts).last();
+#else
+            gpgKey = QString::fromUtf8(line).split("using RSA key", QString::SkipEmptyParts).last();
+#endif
+            gpgKey.append('\n');
+         }
+      }
+      else if (lineLength >= 8 && std::memcmp(data + lineStart, "log size", 8) == 0)
+      {
+         flushCommit();
+
+         processingCommit = true;
+
+         if (!gpg.isEmpty())
+         {
+            goodSignature = gpg.contains("Good signature");
+            gpg.clear();
+         }
+         else
+            goodSignature = false;
+      }
+      else if (processingCommit)
+      {
+         if (commitStart == -1)
+            commitStart = lineStart;
+
+         commitEnd = end + 1;
+      }
+   }
+
+   flushCommit();
+
+   return commits;
+}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <CommitInfo.h>
+
+#include <QByteArray>
+#include <QVector>
+
+/**
+ * @brief The GitLogParser namespace contains the functions that turn the raw output of the git log command used by
+ * the GitRepoLoader into revisions. The buffer is never split or copied: the records are located in place.
+ */
+namespace GitLogParser
+{
+/**
+ * @brief The format of the records the parser understands. It's used together with the options --log-size, --parents
+ * and -z.
+ */
+constexpr auto LOG_FORMAT = "%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n%b ";
+
+// Same format without the body. The bodies are loaded on demand by GitCommitBodies.
+constexpr auto LOG_FORMAT_NO_BODY = "%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n ";
+
+/**
+ * @brief Parses the NUL-delimited output of git log.
+ *
+ * @param log The raw output.
+ * @return The valid revisions in the same order they are in the log.
+ */
+QVector<CommitInfo> parseUnsignedLog(const QByteArray &log);
+
+/**
+ * @brief Parses the output of git log when log.showSignature is enabled. The GPG output is interleaved with the
+ * records.
+ *
+ * @param log The raw output. The NUL separators are replaced in place by new lines.
+ * @return The valid revisions in the same order they are in the log.
+ */
+QVector<CommitInfo> parseSignedLog(QByteArray &log);
+}
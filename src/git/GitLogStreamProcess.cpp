@@ -0,0 +1,47 @@
+#include "GitLogStreamProcess.h"
+
+GitLogStreamProcess::GitLogStreamProcess(const QString &workingDir)
+   : AGitProcess(workingDir)
+{
+}
+
+GitExecResult GitLogStreamProcess::run(const QString &command)
+{
+   const auto ret = execute(command);
+
+   return { ret, "" };
+}
+
+void GitLogStreamProcess::onReadyStandardOutput()
+{
+   if (mCanceling)
+      return;
+
+   mPendingData.append(readAllStandardOutput());
+
+   if (const auto lastSeparator = mPendingData.lastIndexOf('\0'); lastSeparator != -1)
+   {
+      emit signalRecordsReady(mPendingData.left(lastSeparator + 1));
+      mPendingData.remove(0, lastSeparator + 1);
+   }
+}
+
+void GitLogStreamProcess::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+   // The base class consumes whatever is left in the pipe, so it has to be drained first.
+   mPendingData.append(readAllStandardOutput());
+
+   AGitProcess::onFinished(exitCode, exitStatus);
+
+   if (!mCanceling)
+   {
+      if (!mPendingData.isEmpty())
+         emit signalRecordsReady(mPendingData);
+
+      emit signalStreamFinished(!mRealError);
+   }
+
+   mPendingData.clear();
+
+   deleteLater();
+}
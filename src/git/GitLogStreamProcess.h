@@ -0,0 +1,60 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <AGitProcess.h>
+
+/**
+ * @brief The GitLogStreamProcess runs a git command whose output is a sequence of NUL-delimited records (like
+ * git log -z) and delivers the records as soon as they come out of the pipe instead of waiting for the process to
+ * finish. Every emission contains only complete records.
+ */
+class GitLogStreamProcess : public AGitProcess
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief Signal triggered every time a new block of complete records is available.
+    *
+    * @param records The NUL-delimited records.
+    */
+   void signalRecordsReady(const QByteArray &records);
+   /**
+    * @brief Signal triggered when the process finishes and all the records have been delivered.
+    *
+    * @param success True if the process finished without errors, otherwise false.
+    */
+   void signalStreamFinished(bool success);
+
+public:
+   explicit GitLogStreamProcess(const QString &workingDir);
+   GitExecResult run(const QString &command) override;
+
+private:
+   QByteArray mPendingData;
+
+   void onReadyStandardOutput() override;
+   void onFinished(int exitCode, QProcess::ExitStatus exitStatus) override;
+};
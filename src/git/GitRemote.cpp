@@ -2,6 +2,7 @@
 
 #include <GitBase.h>
 #include <GitConfig.h>
+#include <GitFuture.h>
 #include <GitQlientSettings.h>
 #include <GitSubmodules.h>
 
@@ -9,6 +10,22 @@
 
 using namespace QLogger;
 
+namespace
+{
+QString pushCommand(bool force)
+{
+   return QString("git push ").append(force ? QString("--force") : QString());
+}
+
+QString fetchCommand(const QString &gitDir)
+{
+   GitQlientSettings settings(gitDir);
+   const auto pruneOnFetch = settings.localValue("PruneOnFetch", true).toBool();
+
+   return QString("git fetch --all --tags --force %1").arg(pruneOnFetch ? QString("--prune --prune-tags") : QString());
+}
+}
+
 GitRemote::GitRemote(const QSharedPointer<GitBase> &gitBase)
    : mGitBase(gitBase)
 {
@@ -34,7 +51,7 @@ GitExecResult GitRemote::push(bool force)
 {
    QLog_Debug("Git", QString("Executing push"));
 
-   const auto ret = mGitBase->run(QString("git push ").append(force ? QString("--force") : QString()));
+   const auto ret = mGitBase->run(pushCommand(force));
 
    return ret;
 }
@@ -79,12 +96,7 @@ bool GitRemote::fetch()
 {
    QLog_Debug("Git", QString("Executing fetch with prune"));
 
-   GitQlientSettings settings(mGitBase->getGitDir());
-   const auto pruneOnFetch = settings.localValue("PruneOnFetch", true).toBool();
-
-   const auto cmd
-       = QString("git fetch --all --tags --force %1").arg(pruneOnFetch ? QString("--prune --prune-tags") : QString());
-   const auto ret = mGitBase->run(cmd).success;
+   const auto ret = mGitBase->run(fetchCommand(mGitBase->getGitDir())).success;
 
    return ret;
 }
@@ -118,3 +130,42 @@ GitExecResult GitRemote::removeRemote(const QString &remoteName)
 
    return mGitBase->run(QString("git remote rm %1").arg(remoteName));
 }
+
+QFuture<GitExecResult> GitRemote::pushAsync(bool force)
+{
+   QLog_Debug("Git", QString("Executing push asynchronously"));
+
+   return mGitBase->runAsync(pushCommand(force));
+}
+
+QFuture<GitExecResult> GitRemote::pullAsync()
+{
+   QLog_Debug("Git", QString("Executing pull asynchronously"));
+
+   GitQlientSettings settings(mGitBase->getGitDir());
+   const auto updateOnPull = settings.localValue("UpdateOnPull", true).toBool();
+   const auto git = mGitBase;
+
+   return GitFuture::andThen(mGitBase->runAsync("git pull --ff-only"), [git, updateOnPull](const GitExecResult &ret) {
+      if (!updateOnPull)
+         return GitFuture::finished(ret);
+
+      // The result of the pull is kept when the submodules are updated.
+      return GitFuture::andThen(git->runAsync("git submodule update --init --recursive"),
+                                [ret](const GitExecResult &) { return GitFuture::finished(ret); });
+   });
+}
+
+QFuture<GitExecResult> GitRemote::fetchAsync(GitScheduler::Priority priority)
+{
+   QLog_Debug("Git", QString("Executing fetch asynchronously"));
+
+   return mGitBase->runAsync(fetchCommand(mGitBase->getGitDir()), priority);
+}
+
+QFuture<GitExecResult> GitRemote::pruneAsync()
+{
+   QLog_Debug("Git", QString("Executing prune asynchronously"));
+
+   return mGitBase->runAsync("git remote prune origin");
+}
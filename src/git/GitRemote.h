@@ -24,7 +24,9 @@
  ***************************************************************************************/
 
 #include <GitExecResult.h>
+#include <GitScheduler.h>
 
+#include <QFuture>
 #include <QSharedPointer>
 
 class GitBase;
@@ -43,6 +45,12 @@ public:
    GitExecResult addRemote(const QString &remoteRepo, const QString &remoteName);
    GitExecResult removeRemote(const QString &remoteName);
 
+   // Asynchronous versions of the network operations. Canceling the future stops git.
+   QFuture<GitExecResult> pushAsync(bool force = false);
+   QFuture<GitExecResult> pullAsync();
+   QFuture<GitExecResult> fetchAsync(GitScheduler::Priority priority = GitScheduler::Priority::Interactive);
+   QFuture<GitExecResult> pruneAsync();
+
 private:
    QSharedPointer<GitBase> mGitBase;
 };
@@ -1,21 +1,172 @@
 #include "GitRepoLoader.h"
 
+#include <CommitGraphFile.h>
 #include <GitBase.h>
 #include <GitBranches.h>
 #include <GitCache.h>
+#include <GitCommitTexts.h>
 #include <GitConfig.h>
 #include <GitLocal.h>
+#include <GitLogParser.h>
+#include <GitLogStreamProcess.h>
 #include <GitQlientSettings.h>
 #include <GitRequestorProcess.h>
 #include <GitWip.h>
+#include <HistoryCacheFile.h>
+#include <ReferencesReader.h>
+#include <Tracer.h>
 
 #include <QLogger.h>
 
 #include <QDir>
 
+#include <algorithm>
+#include <queue>
+
 using namespace QLogger;
 
-static const char *GIT_LOG_FORMAT("%m%HX%P%n%cn<%ce>%n%an<%ae>%n%at%n%s%n%b ");
+// While streaming, the UI is notified of new rows at most once per interval (the first batch is always notified).
+static const int STREAM_NOTIFY_INTERVAL_MS = 250;
+
+// Above this number of references the command line to load only the new revisions gets too long.
+static const int MAX_DELTA_TIPS = 500;
+
+namespace
+{
+/**
+ * @brief Sorts the commits of the graph reachable from @p tips like git log does: a commit is never shown before all
+ * its children. Otherwise, --date-order shows the most recent commit first and --topo-order shows the commits of a
+ * line of history together.
+ *
+ * @return The positions of the commits in the graph or an empty vector if the graph is not consistent.
+ */
+QVector<int> sortCommitGraph(const CommitGraphFile &graph, const QVector<int> &tips, bool topoOrder)
+{
+   const auto count = graph.count();
+
+   // Zero for the commits that are not reachable. Otherwise, one plus the number of children still to be shown.
+   QVector<int> indegree(count, 0);
+   QVector<int> reachable;
+   QVector<int> pending;
+
+   for (const auto tip : tips)
+   {
+      if (indegree[tip] == 0)
+      {
+         indegree[tip] = 1;
+         pending.append(tip);
+      }
+   }
+
+   while (!pending.isEmpty())
+   {
+      const auto position = pending.takeLast();
+      const auto parents = graph.parents(position);
+
+      reachable.append(position);
+
+      for (const auto parent : parents)
+      {
+         if (parent < 0 || parent >= count)
+            return {};
+
+         if (indegree[parent] == 0)
+         {
+            indegree[parent] = 1;
+            pending.append(parent);
+         }
+      }
+   }
+
+   for (const auto position : qAsConst(reachable))
+   {
+      const auto parents = graph.parents(position);
+
+      for (const auto parent : parents)
+         ++indegree[parent];
+   }
+
+   struct Entry
+   {
+      qint64 date;
+      int order;
+      int position;
+
+      bool operator<(const Entry &other) const
+      {
+         return date != other.date ? date < other.date : order > other.order;
+      }
+   };
+
+   // --date-order pops the most recent commit (the first one inserted on ties) and --topo-order the last inserted.
+   std::priority_queue<Entry> byDate;
+   QVector<int> byTopology;
+   auto inserted = 0;
+
+   const auto push = [&](int position) {
+      if (topoOrder)
+         byTopology.append(position);
+      else
+         byDate.push({ graph.commitDate(position), inserted++, position });
+   };
+
+   // The tips go from the oldest to the most recent so the most recent is shown first in both orders.
+   auto sortedTips = tips;
+   std::sort(sortedTips.begin(), sortedTips.end(),
+             [&graph](int a, int b) { return graph.commitDate(a) < graph.commitDate(b); });
+
+   for (const auto tip : qAsConst(sortedTips))
+   {
+      if (indegree[tip] == 1)
+      {
+         indegree[tip] = 0;
+         push(tip);
+      }
+   }
+
+   QVector<int> sorted;
+   sorted.reserve(reachable.count());
+
+   while (!byDate.empty() || !byTopology.isEmpty())
+   {
+      int position;
+
+      if (topoOrder)
+         position = byTopology.takeLast();
+      else
+      {
+         position = byDate.top().position;
+         byDate.pop();
+      }
+
+      sorted.append(position);
+
+      const auto parents = graph.parents(position);
+
+      for (const auto parent : parents)
+      {
+         if (--indegree[parent] == 1)
+         {
+            indegree[parent] = 0;
+            push(parent);
+         }
+      }
+   }
+
+   return sorted;
+}
+
+QString joinTips(const QVector<ObjectId> &tips)
+{
+   QStringList shas;
+   shas.reserve(tips.count());
+
+   for (const auto &tip : tips)
+      shas.append(tip.toString());
+
+   return shas.join(QLatin1Char(' '));
+}
+}
 
 GitRepoLoader::GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<GitCache> cache,
                              const QSharedPointer<GitQlientSettings> &settings, QObject *parent)
@@ -23,7 +174,19 @@ GitRepoLoader::GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<Git
    , mGitBase(gitBase)
    , mRevCache(std::move(cache))
    , mSettings(settings)
+   , mReferencesReader(gitBase)
+   , mCommitTexts(new GitCommitTexts(gitBase, mRevCache, this))
 {
+   qRegisterMetaType<QVector<int>>("QVector<int>");
+
+   // The rows request their texts from the GUI thread, they are loaded here.
+   connect(mRevCache.data(), &GitCache::signalCommitTextsRequested, mCommitTexts, &GitCommitTexts::load);
+   connect(mCommitTexts, &GitCommitTexts::signalAllTextsLoaded, this, &GitRepoLoader::signalCommitTextsLoaded);
+
+   connect(mRevCache.data(), &GitCache::signalLanesCompleted, this, [this]() {
+      if (mPersistPending)
+         persistHistoryCache();
+   });
 }
 
 void GitRepoLoader::cancelAll()
@@ -123,6 +286,9 @@ bool GitRepoLoader::configureRepoDirectory()
 {
    QLog_Debug("Git", "Configuring repository directory.");
 
+   // Every load starts here, the span finishes when all the steps are done.
+   mLoadTraceStart = Tracer::getInstance()->isEnabled() ? Tracer::getInstance()->now() : -1;
+
    const auto ret = mGitBase->run("git rev-parse --show-cdup");
 
    if (ret.success)
@@ -138,8 +304,21 @@ bool GitRepoLoader::configureRepoDirectory()
 
 void GitRepoLoader::requestReferences()
 {
+   TRACE_SPAN("Git", "Request references");
+
    QLog_Debug("Git", "Loading references...");
 
+   if (mSettings->localValue("NativeReferences", true).toBool())
+   {
+      if (const auto references = mReferencesReader.read(); references)
+      {
+         insertReferences(*references);
+         return;
+      }
+
+      QLog_Info("Git", "The references can't be read natively, git show-ref is used instead.");
+   }
+
    const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
    connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processReferences);
    connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
@@ -149,71 +328,81 @@ void GitRepoLoader::requestReferences()
 
 void GitRepoLoader::processReferences(QByteArray ba)
 {
+   insertReferences(ReferencesReader::parseShowRef(ba));
+}
+
+void GitRepoLoader::insertReferences(const QVector<ReferencesReader::Reference> &references)
+{
+   TRACE_SPAN("Git", "Insert references");
+
    if (mRefreshReferences)
       mRevCache->clearReferences();
 
-   QString prevRefSha;
-   const auto referencesList = ba.split('\n');
-
-   for (const auto &reference : referencesList)
+   for (const auto &reference : references)
    {
-      if (!reference.isEmpty())
+      const auto &refName = reference.name;
+
+      if (!refName.startsWith("refs/tags/") || (refName.startsWith("refs/tags/") && refName.endsWith("^{}")))
       {
-         auto revSha = QString::fromUtf8(reference.left(40));
-         const auto refName = reference.mid(41);
+         References::Type type;
+         QString name;
 
-         if (!refName.startsWith("refs/tags/") || (refName.startsWith("refs/tags/") && refName.endsWith("^{}")))
+         if (refName.startsWith("refs/tags/"))
          {
-            References::Type type;
-            QString name;
-
-            if (refName.startsWith("refs/tags/"))
-            {
-               type = References::Type::LocalTag;
-               name = QString::fromUtf8(refName.mid(10, reference.length()));
-               name.remove("^{}");
-            }
-            else if (refName.startsWith("refs/heads/"))
-            {
-               type = References::Type::LocalBranch;
-               name = QString::fromUtf8(refName.mid(11));
-            }
-            else if (refName.startsWith("refs/remotes/") && !refName.endsWith("HEAD"))
-            {
-               type = References::Type::RemoteBranches;
-               name = QString::fromUtf8(refName.mid(13));
-            }
-            else
-               continue;
-
-            mRevCache->insertReference(revSha, type, name);
+            type = References::Type::LocalTag;
+            name = QString::fromUtf8(refName.mid(10));
+            name.remove("^{}");
          }
-         prevRefSha = revSha;
+         else if (refName.startsWith("refs/heads/"))
+         {
+            type = References::Type::LocalBranch;
+            name = QString::fromUtf8(refName.mid(11));
+         }
+         else if (refName.startsWith("refs/remotes/") && !refName.endsWith("HEAD"))
+         {
+            type = References::Type::RemoteBranches;
+            name = QString::fromUtf8(refName.mid(13));
+         }
+         else
+            continue;
+
+         mRevCache->insertReference(reference.sha.toString(), type, name);
       }
    }
 
    mRevCache->reloadCurrentBranchInfo(mGitBase->getCurrentBranch(), mGitBase->getLastCommit().output.trimmed());
 
-   --mSteps;
-
-   if (mSteps == 0)
-   {
-      mRevCache->setConfigurationDone();
-
-      emit signalLoadingFinished(mRefreshReferences);
-
-      mLocked = false;
-      mRefreshReferences = false;
-   }
+   notifyLoadStepDone();
 }
 
 void GitRepoLoader::requestRevisions()
 {
+   TRACE_SPAN("Git", "Request revisions");
+
    QLog_Debug("Git", "Loading revisions...");
 
    const auto maxCommits = mSettings->localValue("MaxCommits", 0).toInt();
-   const auto commitsToRetrieve = maxCommits != 0 ? QString::fromUtf8("-n %1").arg(maxCommits)
-                                                  : mShowAll ? QString("--all") : mGitBase->getCurrentBranch();
+   const auto initialized = mRevCache->isInitialized();
+
+   // The pending page belongs to the previous history: its output is dropped when it arrives.
+   ++mPageGeneration;
+   mPageInFlight = false;
+
+   // MaxCommits truncates the history on purpose, while the pages are loaded as the user scrolls down. A reload keeps
+   // the pages that were already loaded.
+   mPageSize = maxCommits == 0 ? mSettings->localValue("HistoryPageSize", 0).toInt() : 0;
+   mPageRevisions = mShowAll ? QString("--all") : mGitBase->getCurrentBranch();
+   mHistoryComplete = mPageSize <= 0;
+
+   auto commitsToRetrieve = mPageRevisions;
+
+   if (maxCommits != 0)
+      commitsToRetrieve = QString::fromUtf8("-n %1").arg(maxCommits);
+   else if (mPageSize > 0)
+   {
+      mRequestedCommits = std::max(mPageSize, initialized ? mRevCache->commitCount() - 1 : 0);
+      commitsToRetrieve = QString::fromUtf8("-n %1 %2").arg(mRequestedCommits).arg(mPageRevisions);
+   }
 
    QString order;
 
@@ -233,49 +422,401 @@ void GitRepoLoader::requestRevisions()
          break;
    }
 
-   const auto baseCmd = QString("git log %1 --no-color --log-size --parents --boundary -z --pretty=format:%2 %3")
-                            .arg(order, QString::fromUtf8(GIT_LOG_FORMAT), commitsToRetrieve);
+   const auto lazyBodies = mSettings->localValue("LazyCommitBodies", false).toBool();
+   const auto format = lazyBodies ? GitLogParser::LOG_FORMAT_NO_BODY : GitLogParser::LOG_FORMAT;
+   mLogOptions
+       = QString("%1 --no-color --log-size --parents -z --pretty=format:%2").arg(order, QString::fromUtf8(format));
+   // The boundary commits aren't counted by -n but they are stored as commits, so with them the --skip of the next
+   // page would leave out as many commits of the log.
+   const auto boundary = mPageSize > 0 ? QString() : QString(" --boundary");
+   const auto baseCmd = QString("git log %1%2 %3").arg(mLogOptions, boundary, commitsToRetrieve);
+   mHistoryCommand = baseCmd;
+
+   mRevCache->setLazyBodies(lazyBodies);
 
-   if (!mRevCache->isInitialized())
+   if (!initialized)
       emit signalLoadingStarted();
 
+   QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
+   const auto ret = gitConfig->getGitValue("log.showSignature");
+   mShowSignature = ret.success ? ret.output.contains("true") : false;
+
+   // A partial history can't be extended with the new revisions, so the tips are only tracked when all the commits
+   // are loaded.
+   const auto fullHistory = maxCommits == 0 && mPageSize <= 0;
+   mRequestedHistory.options = mShowSignature ? baseCmd + QString(" --show-signature") : baseCmd;
+   mRequestedHistory.tips = fullHistory ? currentTips(commitsToRetrieve) : QVector<ObjectId>();
+   mUseHistoryCache = !mRequestedHistory.tips.isEmpty() && mSettings->localValue("HistoryCache", true).toBool();
+
+   if (initialized && loadNewRevisions())
+      return;
+
+   if (!initialized && mUseHistoryCache && loadHistoryCache())
+      return;
+
+   // The commit-graph only has the commit dates, so it can't sort the history by author date.
+   if (!initialized && !mShowSignature && order != QString("--author-date-order")
+       && mSettings->localValue("CommitGraph", true).toBool() && loadCommitGraph(order == QString("--topo-order")))
+      return;
+
+   requestFullRevisions();
+}
+
+void GitRepoLoader::requestFullRevisions()
+{
+   // Signed logs interleave the GPG output with the records so they can't be split on the fly. Reloads keep the
+   // previous history on screen until the new one is ready, so only the first load is streamed.
+   if (!mRevCache->isInitialized() && !mShowSignature && mSettings->localValue("StreamHistory", true).toBool())
+   {
+      requestRevisionsStream(mHistoryCommand);
+      return;
+   }
+
    const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
    connect(requestor, &GitRequestorProcess::procDataReady, this, &GitRepoLoader::processRevisions);
    connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
 
-   requestor->run(baseCmd);
+   requestor->run(mHistoryCommand);
 }
 
-void GitRepoLoader::processRevisions(QByteArray ba)
+QVector<ObjectId> GitRepoLoader::currentTips(const QString &revisions) const
 {
-   QLog_Info("Git", "Revisions received!");
+   // git log --all also walks from HEAD, that can be detached. It's kept first so checking out another branch changes
+   // the tips even if the set of references is the same.
+   const auto ret = mGitBase->run(QString("git rev-parse HEAD %1").arg(revisions));
 
-   QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
-   const auto serverUrl = gitConfig->getServerHost();
+   if (!ret.success)
+      return {};
 
-   if (serverUrl.contains("github"))
-      QLog_Info("Git", "Requesting PR status!");
+   QVector<ObjectId> tips;
+   const auto lines = ret.output.split('\n');
 
-   QLog_Debug("Git", "Processing revisions...");
+   for (const auto &line : lines)
+   {
+      if (const auto tip = ObjectId::fromString(line.trimmed()); tip.isValid())
+         tips.append(tip);
+   }
 
-   const auto initialized = mRevCache->isInitialized();
+   if (!tips.isEmpty())
+   {
+      std::sort(tips.begin() + 1, tips.end());
+      tips.erase(std::unique(tips.begin() + 1, tips.end()), tips.end());
+   }
 
-   if (!initialized)
-      emit signalLoadingStarted();
+   return tips;
+}
 
-   const auto ret = gitConfig->getGitValue("log.showSignature");
-   const auto showSignature = ret.success ? ret.output.contains("true") : false;
-   auto commits = showSignature ? processSignedLog(ba) : processUnsignedLog(ba);
+QString GitRepoLoader::historyCachePath() const
+{
+   return QString("%1/GitQlientHistory.cache").arg(mGitBase->getGitDir());
+}
+
+bool GitRepoLoader::loadHistoryCache()
+{
+   TRACE_SPAN("Git", "Load history cache");
+
+   HistoryCacheFile file(historyCachePath());
+   const auto cached = file.readHeader();
+
+   if (!cached || cached->options != mRequestedHistory.options)
+      return false;
+
+   const auto sameTips = cached->tips == mRequestedHistory.tips;
+
+   if (!sameTips && !isHistoryContained(cached->tips))
+      return false;
+
+   HistoryCacheFile::Header header;
+   CommitStore store;
+   QVector<int> rows;
+
+   if (!file.read(header, store, rows))
+   {
+      QLog_Warning("Git", "The history cache is corrupted and will be rebuilt.");
+      return false;
+   }
+
+   if (sameTips)
+   {
+      QLog_Info("Git", "Revisions restored from the history cache.");
+
+      restoreHistoryCache(std::move(store), std::move(rows), {}, false);
+
+      return true;
+   }
+
+   requestNewRevisions(header.tips, [this, store, rows](QVector<CommitInfo> newCommits) mutable {
+      QLog_Info("Git", QString("Revisions restored from the history cache with {%1} new revisions.")
+                           .arg(newCommits.count()));
+
+      restoreHistoryCache(std::move(store), std::move(rows), std::move(newCommits), true);
+   });
+
+   return true;
+}
+
+void GitRepoLoader::restoreHistoryCache(CommitStore store, QVector<int> rows, QVector<CommitInfo> newCommits,
+                                        bool tipsChanged)
+{
    QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
-   const auto files = git->getUntrackedFiles();
 
-   mRevCache->setUntrackedFilesList(std::move(files));
-   mRevCache->setup(git->getWipInfo(), std::move(commits));
+   mRevCache->restore(std::move(store), std::move(rows));
+   mRevCache->spliceCommits(git->getWipInfo(), std::move(newCommits));
+
+   mLoadedHistory = mRequestedHistory;
+
+   if (tipsChanged)
+      persistHistoryCache();
+
+   notifyLoadStepDone();
+}
+
+bool GitRepoLoader::loadNewRevisions()
+{
+   TRACE_SPAN("Git", "Load new revisions");
+
+   if (mRequestedHistory.tips.isEmpty() || mRequestedHistory.options != mLoadedHistory.options)
+      return false;
 
+   if (mRequestedHistory.tips == mLoadedHistory.tips)
+   {
+      spliceNewRevisions({});
+      return true;
+   }
+
+   if (!isHistoryContained(mLoadedHistory.tips))
+      return false;
+
+   requestNewRevisions(mLoadedHistory.tips,
+                       [this](QVector<CommitInfo> newCommits) { spliceNewRevisions(std::move(newCommits)); });
+
+   return true;
+}
+
+void GitRepoLoader::spliceNewRevisions(QVector<CommitInfo> newCommits)
+{
+   QLog_Info("Git", QString("Reloading the history with {%1} new revisions.").arg(newCommits.count()));
+
+   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
+
+   const auto rows = mRevCache->spliceCommits(git->getWipInfo(), std::move(newCommits));
+
+   emit signalRevisionsInserted(rows);
+
+   mLoadedHistory = mRequestedHistory;
+
+   if (!rows.isEmpty())
+      persistHistoryCache();
+
+   notifyLoadStepDone();
+}
+
+bool GitRepoLoader::loadCommitGraph(bool topoOrder)
+{
+   TRACE_SPAN("Git", "Load commit-graph");
+
+   CommitGraphFile graph(objectsPath());
+
+   if (mRequestedHistory.tips.isEmpty() || !graph.open())
+      return false;
+
+   QVector<int> graphTips;
+   QVector<ObjectId> graphTipShas;
+
+   for (const auto &tip : qAsConst(mRequestedHistory.tips))
+   {
+      if (const auto position = graph.position(tip); position != -1)
+      {
+         graphTips.append(position);
+         graphTipShas.append(tip);
+      }
+   }
+
+   if (graphTips.isEmpty())
+      return false;
+
+   const auto positions = sortCommitGraph(graph, graphTips, topoOrder);
+
+   if (positions.isEmpty())
+   {
+      QLog_Warning("Git", "The commit-graph is not valid, the history is loaded with git log.");
+      return false;
+   }
+
+   QVector<CommitInfo> commits;
+   commits.reserve(positions.count());
+
+   for (const auto position : positions)
+   {
+      const auto parentPositions = graph.parents(position);
+      QStringList parents;
+      parents.reserve(parentPositions.count());
+
+      for (const auto parent : parentPositions)
+         parents.append(graph.objectId(parent).toString());
+
+      commits.append(CommitInfo(graph.objectId(position).toString(), parents,
+                                std::chrono::seconds(graph.commitDate(position)), QString()));
+   }
+
+   QLog_Info("Git", QString("Topology of {%1} revisions loaded from the commit-graph.").arg(commits.count()));
+
+   if (graphTips.count() == mRequestedHistory.tips.count())
+   {
+      setupCommitGraph(std::move(commits), {});
+      return true;
+   }
+
+   // The tips that aren't in the graph have commits written after it was updated, they are loaded with git log.
+   requestNewRevisions(graphTipShas, [this, commits](QVector<CommitInfo> newCommits) mutable {
+      setupCommitGraph(std::move(commits), std::move(newCommits));
+   });
+
+   return true;
+}
+
+void GitRepoLoader::setupCommitGraph(QVector<CommitInfo> commits, QVector<CommitInfo> newCommits)
+{
+   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
+
+   const auto wipInfo = git->getWipInfo();
+
+   mRevCache->setupTopology(wipInfo, std::move(commits));
+
+   if (!newCommits.isEmpty())
+      mRevCache->spliceCommits(wipInfo, std::move(newCommits));
+
+   mLoadedHistory = mRequestedHistory;
+
+   persistHistoryCache();
+
+   notifyLoadStepDone();
+}
+
+QString GitRepoLoader::objectsPath() const
+{
+   return QString("%1/objects").arg(mGitBase->getCommonDir());
+}
+
+bool GitRepoLoader::isHistoryContained(const QVector<ObjectId> &cachedTips) const
+{
+   const auto &tips = mRequestedHistory.tips;
+
+   if (cachedTips.count() + tips.count() > MAX_DELTA_TIPS)
+      return false;
+
+   // All the cached commits must still be reachable from the current tips, otherwise the cache has commits that
+   // don't belong to the history anymore.
+   const auto ret = mGitBase->run(QString("git rev-list --count %1 --not %2").arg(joinTips(cachedTips), joinTips(tips)));
+
+   return ret.success && ret.output.trimmed() == QString("0");
+}
+
+void GitRepoLoader::requestNewRevisions(const QVector<ObjectId> &cachedTips,
+                                        const std::function<void(QVector<CommitInfo>)> &onLoaded)
+{
+   // The records are only parsed once git finishes, so the signed logs can be streamed as well.
+   const auto requestor = new GitLogStreamProcess(mGitBase->getWorkingDir());
+   const auto log = QSharedPointer<QByteArray>::create();
+
+   connect(requestor, &GitLogStreamProcess::signalRecordsReady, this,
+           [log](const QByteArray &records) { log->append(records); });
+   connect(requestor, &GitLogStreamProcess::signalStreamFinished, this, [this, log, onLoaded](bool success) {
+      if (success)
+         onLoaded(mShowSignature ? GitLogParser::parseSignedLog(*log) : GitLogParser::parseUnsignedLog(*log));
+      else
+      {
+         QLog_Warning("Git", "The new revisions couldn't be loaded, the full history is requested instead.");
+         requestFullRevisions();
+      }
+   });
+   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+   const auto command
+       = QString("git log %1 %2 --not %3").arg(mLogOptions, joinTips(mRequestedHistory.tips), joinTips(cachedTips));
+
+   if (!requestor->run(command).success)
+   {
+      requestor->deleteLater();
+      requestFullRevisions();
+   }
+}
+
+void GitRepoLoader::persistHistoryCache()
+{
+   TRACE_SPAN("Git", "Persist history cache");
+
+   // The lanes are part of the cache: it is written once the background computation finishes.
+   mPersistPending = mUseHistoryCache && !mRevCache->lanesComplete();
+
+   if (mUseHistoryCache && !mPersistPending
+       && !mRevCache->persist(HistoryCacheFile(historyCachePath()), mLoadedHistory))
+   {
+      QLog_Warning("Git", "The history cache couldn't be written.");
+   }
+}
+
+void GitRepoLoader::requestRevisionsStream(const QString &command)
+{
+   QLog_Debug("Git", "Streaming revisions...");
+
+   const auto requestor = new GitLogStreamProcess(mGitBase->getWorkingDir());
+   connect(requestor, &GitLogStreamProcess::signalRecordsReady, this, &GitRepoLoader::processRevisionsChunk);
+   connect(requestor, &GitLogStreamProcess::signalStreamFinished, this, &GitRepoLoader::onRevisionsStreamFinished);
+   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
+
+   requestor->run(command);
+
+   // Git keeps writing into the pipe while the WIP is computed. The records are only processed once the control
+   // returns to the event loop, so the cache is always ready before the first one arrives.
+   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
+   mRevCache->beginSetup(git->getWipInfo());
+
+   mStreamTimer.invalidate();
+}
+
+void GitRepoLoader::processRevisionsChunk(const QByteArray &records)
+{
+   TRACE_SPAN("Git", "Process revisions chunk");
+
+   const auto totalCommits = mRevCache->appendCommits(GitLogParser::parseUnsignedLog(records));
+
+   if (!mStreamTimer.isValid() || mStreamTimer.elapsed() >= STREAM_NOTIFY_INTERVAL_MS)
+   {
+      mStreamTimer.start();
+
+      emit signalRevisionsAppended(totalCommits);
+   }
+}
+
+void GitRepoLoader::onRevisionsStreamFinished()
+{
+   TRACE_SPAN("Git", "Finish revisions stream");
+
+   QLog_Info("Git", "Revisions streaming finished!");
+
+   mRevCache->finishSetup();
+
+   mHistoryComplete = mPageSize <= 0 || mRevCache->commitCount() - 1 < mRequestedCommits;
+
+   emit signalRevisionsAppended(mRevCache->commitCount());
+
+   mLoadedHistory = mRequestedHistory;
+
+   persistHistoryCache();
+
+   notifyLoadStepDone();
+}
+
+void GitRepoLoader::notifyLoadStepDone()
+{
    --mSteps;
 
    if (mSteps == 0)
    {
+      if (mLoadTraceStart >= 0)
+         Tracer::getInstance()->addSpan("Git", "Load repository", mLoadTraceStart, mGitBase->getWorkingDir());
+
       mRevCache->setConfigurationDone();
 
       emit signalLoadingFinished(mRefreshReferences);
@@ -285,87 +826,92 @@ void GitRepoLoader::processRevisions(QByteArray ba)
    }
 }
 
-QVector<CommitInfo> GitRepoLoader::processUnsignedLog(QByteArray &log) const
+void GitRepoLoader::processRevisions(QByteArray ba)
 {
-   auto lines = log.split('\000');
-   QVector<CommitInfo> commits;
-   commits.reserve(lines.count());
+   TRACE_SPAN("Git", "Process revisions");
 
-   auto pos = 0;
-   while (!lines.isEmpty())
-   {
-      if (auto commit = CommitInfo { lines.takeFirst() }; commit.isValid())
-      {
-         commit.pos = ++pos;
-         commits.append(std::move(commit));
-      }
-   }
+   QLog_Info("Git", "Revisions received!");
+
+   QScopedPointer<GitConfig> gitConfig(new GitConfig(mGitBase));
+   const auto serverUrl = gitConfig->getServerHost();
 
-   return commits;
+   if (serverUrl.contains("github"))
+      QLog_Info("Git", "Requesting PR status!");
+
+   QLog_Debug("Git", "Processing revisions...");
+
+   const auto initialized = mRevCache->isInitialized();
+
+   if (!initialized)
+      emit signalLoadingStarted();
+
+   auto commits = mShowSignature ? GitLogParser::parseSignedLog(ba) : GitLogParser::parseUnsignedLog(ba);
+   QScopedPointer<GitWip> git(new GitWip(mGitBase, mRevCache));
+
+   mRevCache->setup(git->getWipInfo(), std::move(commits));
+
+   mHistoryComplete = mPageSize <= 0 || mRevCache->commitCount() - 1 < mRequestedCommits;
+   mLoadedHistory = mRequestedHistory;
+
+   persistHistoryCache();
+
+   notifyLoadStepDone();
 }
 
-QVector<CommitInfo> GitRepoLoader::processSignedLog(QByteArray &log) const
+void GitRepoLoader::loadNextPage()
 {
-   log.replace('\000', '\n');
+   // A reload changes the history the page is appended to, the page is requested again once it finishes.
+   if (mLocked || mPageInFlight || mHistoryComplete || !mRevCache->isInitialized())
+      return;
 
-   QVector<CommitInfo> commits;
+   mPageInFlight = true;
+
+   // The WIP is not part of the log.
+   const auto loadedCommits = mRevCache->commitCount() - 1;
+   const auto generation = mPageGeneration;
+
+   QLog_Debug("Git", QString("Loading {%1} revisions after the first {%2}.").arg(mPageSize).arg(loadedCommits));
 
-   QByteArray commit;
-   QByteArray gpg;
-   QString gpgKey;
-   auto processingCommit = false;
-   auto pos = 1;
-   auto start = 0;
-   int end;
-   bool goodSignature = false;
+   const auto requestor = new GitRequestorProcess(mGitBase->getWorkingDir());
+   connect(requestor, &GitRequestorProcess::procDataReady, this, [this, generation](const QByteArray &ba) {
+      if (generation == mPageGeneration)
+         processPage(ba);
+   });
+   // A canceled process finishes without data, so the flag is cleared when the process goes away.
+   connect(requestor, &QObject::destroyed, this, [this, generation]() {
+      if (generation == mPageGeneration)
+         mPageInFlight = false;
+   });
+   connect(this, &GitRepoLoader::cancelAllProcesses, requestor, &AGitProcess::onCancel);
 
-   while ((end = log.indexOf('\n', start)) != -1)
+   const auto ret = requestor->run(
+       QString("git log %1 --skip=%2 -n %3 %4").arg(mLogOptions).arg(loadedCommits).arg(mPageSize).arg(mPageRevisions));
+
+   if (!ret.success)
    {
-      QByteArray line(log.mid(start, end - start));
-      start = end + 1;
+      mPageInFlight = false;
+      requestor->deleteLater();
+   }
+}
 
-      if (line.startsWith("gpg: "))
-      {
-         processingCommit = false;
-         gpg.append(line);
+void GitRepoLoader::loadCommitTexts()
+{
+   mCommitTexts->loadAll(joinTips(mLoadedHistory.tips));
+}
 
-         if (line.contains("using RSA key"))
-         {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-            gpgKey = QString::fromUtf8(line).split("using RSA key", Qt::SkipEmptyParts).last();
-#else
-            gpgKey = QString::fromUtf8(line).split("using RSA key", QString::SkipEmptyParts).last();
-#endif
-            gpgKey.append('\n');
-         }
-      }
-      else if (line.startsWith("log size"))
-      {
-         if (!commit.isEmpty())
-         {
-            if (auto revision = CommitInfo { commit, gpgKey, goodSignature }; revision.isValid())
-            {
-               revision.pos = pos++;
-               commits.append(std::move(revision));
+void GitRepoLoader::processPage(QByteArray ba)
+{
+   TRACE_SPAN("Git", "Process page");
 
-               gpgKey.clear();
-            }
+   auto commits = mShowSignature ? GitLogParser::parseSignedLog(ba) : GitLogParser::parseUnsignedLog(ba);
 
-            commit.clear();
-         }
-         processingCommit = true;
+   QLog_Info("Git", QString("Page of {%1} revisions received.").arg(commits.count()));
 
-         if (!gpg.isEmpty())
-         {
-            goodSignature = gpg.contains("Good signature");
-            gpg.clear();
-         }
-         else
-            goodSignature = false;
-      }
-      else if (processingCommit)
-         commit.append(line + '\n');
-   }
+   mHistoryComplete = commits.count() < mPageSize;
+
+   const auto totalCommits = mRevCache->appendPage(std::move(commits));
+
+   mPageInFlight = false;
 
-   return commits;
+   emit signalPageLoaded(totalCommits);
 }
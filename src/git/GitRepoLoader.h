@@ -25,13 +25,20 @@
 
 #include <CommitInfo.h>
 #include <GitExecResult.h>
+#include <HistoryCacheFile.h>
+#include <ReferencesReader.h>
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVector>
 
+#include <functional>
+
+class CommitStore;
 class GitBase;
 class GitCache;
+class GitCommitTexts;
 struct WipRevisionInfo;
 class GitQlientSettings;
 
@@ -42,12 +49,18 @@ class GitRepoLoader : public QObject
 signals:
    void signalLoadingStarted();
    void signalLoadingFinished(bool full);
+   void signalRevisionsAppended(int totalCommits);
+   void signalRevisionsInserted(const QVector<int> &rows);
+   void signalPageLoaded(int totalCommits);
+   void signalCommitTextsLoaded();
    void cancelAllProcesses(QPrivateSignal);
 
 public slots:
    void loadLogHistory();
    void loadReferences();
    void loadAll();
+   void loadNextPage();
+   void loadCommitTexts();
 
 public:
    explicit GitRepoLoader(QSharedPointer<GitBase> gitBase, QSharedPointer<GitCache> cache,
@@ -59,16 +72,51 @@ private:
    bool mShowAll = true;
    bool mLocked = false;
    bool mRefreshReferences = true;
+   bool mShowSignature = false;
+   bool mUseHistoryCache = false;
+   bool mHistoryComplete = true;
+   bool mPersistPending = false;
+   bool mPageInFlight = false;
+   int mPageGeneration = 0;
    int mSteps = 0;
+   qint64 mLoadTraceStart = -1;
+   int mPageSize = 0;
+   int mRequestedCommits = 0;
+   QString mPageRevisions;
+   QString mLogOptions;
+   QString mHistoryCommand;
+   HistoryCacheFile::Header mRequestedHistory;
+   HistoryCacheFile::Header mLoadedHistory;
+   QElapsedTimer mStreamTimer;
    QSharedPointer<GitBase> mGitBase;
    QSharedPointer<GitCache> mRevCache;
    QSharedPointer<GitQlientSettings> mSettings;
+   ReferencesReader mReferencesReader;
+   GitCommitTexts *mCommitTexts = nullptr;
 
    bool configureRepoDirectory();
    void requestReferences();
    void processReferences(QByteArray ba);
+   void insertReferences(const QVector<ReferencesReader::Reference> &references);
    void requestRevisions();
+   void requestFullRevisions();
    void processRevisions(QByteArray ba);
-   QVector<CommitInfo> processUnsignedLog(QByteArray &log) const;
-   QVector<CommitInfo> processSignedLog(QByteArray &log) const;
+   void processPage(QByteArray ba);
+   void requestRevisionsStream(const QString &command);
+   void processRevisionsChunk(const QByteArray &records);
+   void onRevisionsStreamFinished();
+   void notifyLoadStepDone();
+   QVector<ObjectId> currentTips(const QString &revisions) const;
+   QString historyCachePath() const;
+   bool loadHistoryCache();
+   void restoreHistoryCache(CommitStore store, QVector<int> rows, QVector<CommitInfo> newCommits, bool tipsChanged);
+   bool loadNewRevisions();
+   void spliceNewRevisions(QVector<CommitInfo> newCommits);
+   bool loadCommitGraph(bool topoOrder);
+   void setupCommitGraph(QVector<CommitInfo> commits, QVector<CommitInfo> newCommits);
+   QString objectsPath() const;
+   bool isHistoryContained(const QVector<ObjectId> &cachedTips) const;
+   void requestNewRevisions(const QVector<ObjectId> &cachedTips,
+                            const std::function<void(QVector<CommitInfo>)> &onLoaded);
+   void persistHistoryCache();
 };
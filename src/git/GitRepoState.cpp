@@ -0,0 +1,227 @@
+#include "GitRepoState.h"
+
+#include <GitBase.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+namespace
+{
+// Time the changes of the files are gathered before the state is checked. A checkout or a rebase writes many of them.
+const int CHANGES_DELAY_MS = 100;
+
+// The files in the git directory that tell which operation is in progress.
+const char *const OPERATION_FILES[] = { "rebase-merge", "rebase-apply", "MERGE_HEAD", "CHERRY_PICK_HEAD",
+                                        "REVERT_HEAD" };
+
+const RepoState::Operation OPERATIONS[] = { RepoState::Operation::Rebase, RepoState::Operation::Rebase,
+                                            RepoState::Operation::Merge, RepoState::Operation::CherryPick,
+                                            RepoState::Operation::Revert };
+
+qint64 modificationTime(const QString &path)
+{
+   const QFileInfo info(path);
+
+   return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+}
+
+GitRepoState::GitRepoState(const GitBase *git)
+   : mGit(git)
+{
+   // It's created by the first thread that needs it, that may finish before the repository is closed.
+   if (const auto app = QCoreApplication::instance(); app && thread() != app->thread())
+      moveToThread(app->thread());
+
+   QMetaObject::invokeMethod(this, &GitRepoState::startWatching, Qt::QueuedConnection);
+}
+
+void GitRepoState::startWatching()
+{
+   QMutexLocker lock(&mGitMutex);
+
+   if (!mGit)
+      return;
+
+   mWatcher = new QFileSystemWatcher(this);
+   mChangesTimer = new QTimer(this);
+   mChangesTimer->setSingleShot(true);
+   mChangesTimer->setInterval(CHANGES_DELAY_MS);
+
+   connect(mChangesTimer, &QTimer::timeout, this, &GitRepoState::onChangesTimeout);
+   connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, &GitRepoState::onPathChanged);
+
+   // Git replaces the files through a rename, so the directories are watched instead of the files.
+   const auto gitDir = mGit->getGitDir();
+   const auto commonDir = mGit->getCommonDir();
+
+   for (const auto &dir : { gitDir, commonDir, QString("%1/refs/heads").arg(commonDir) })
+   {
+      if (QFileInfo(dir).isDir() && !mWatcher->directories().contains(dir))
+         mWatcher->addPath(dir);
+   }
+}
+
+std::shared_ptr<const RepoState> GitRepoState::state()
+{
+   auto state = std::atomic_load(&mState);
+
+   if (!state)
+   {
+      refresh();
+      state = std::atomic_load(&mState);
+   }
+
+   // Only a detached state has nothing to read.
+   return state ? state : std::make_shared<const RepoState>();
+}
+
+void GitRepoState::refresh()
+{
+   QMutexLocker lock(&mGitMutex);
+
+   if (mGit)
+      readState();
+}
+
+void GitRepoState::detach()
+{
+   QMutexLocker lock(&mGitMutex);
+
+   mGit = nullptr;
+}
+
+void GitRepoState::readState()
+{
+   QLog_Trace("Git", "Refreshing the repository state");
+
+   auto state = std::make_shared<RepoState>();
+
+   if (QFile headFile(mGit->getGitDir() + "/HEAD"); headFile.open(QIODevice::ReadOnly))
+   {
+      const auto head = QString::fromUtf8(headFile.readAll().trimmed());
+      const auto branchPrefix = QString("ref: refs/heads/");
+
+      // It's the same name git rev-parse --abbrev-ref HEAD gives.
+      state->currentBranch = head.startsWith(branchPrefix) ? head.mid(branchPrefix.length()) : QString("HEAD");
+   }
+
+   // The stamp is taken before reading, so a change in the middle is seen in the next check.
+   state->stamp = readStamp(state->currentBranch);
+
+   if (const auto ret = mGit->resolve("HEAD"); ret.success)
+      state->head = ret.output;
+
+   // The list never fails, unlike getting a key that isn't set. The keys are in lower case, but not the branch names.
+   if (const auto ret = mGit->run("git config --list"); ret.success)
+   {
+      auto manyFiles = false;
+      auto untrackedCache = QString();
+      const auto branchSection = QString("branch.%1.").arg(state->currentBranch);
+      QString upstreamRemote;
+      QString upstreamMerge;
+
+      for (const auto &line : ret.output.split('\n'))
+      {
+         const auto value = line.mid(line.indexOf('=') + 1);
+
+         if (line.startsWith("core.untrackedcache="))
+            untrackedCache = value;
+         else if (line.startsWith("feature.manyfiles="))
+            manyFiles = value == QLatin1String("true");
+         else if (line.startsWith("core.fsmonitor=") && value != QLatin1String("false"))
+            state->fsmonitor = value;
+         else if (!state->isDetached() && line.startsWith(branchSection + "remote="))
+            upstreamRemote = value;
+         else if (!state->isDetached() && line.startsWith(branchSection + "merge="))
+            upstreamMerge = value;
+      }
+
+      // The feature for big repositories turns the untracked cache on unless it's set explicitly.
+      state->untrackedCache = untrackedCache.isEmpty() ? manyFiles
+                                                       : untrackedCache == QLatin1String("true")
+                                                             || untrackedCache == QLatin1String("keep");
+
+      // The same short name as %(upstream:short): the remote branch, or the local one when the remote is ".".
+      if (!upstreamRemote.isEmpty() && !upstreamMerge.isEmpty())
+      {
+         const auto headsPrefix = QString("refs/heads/");
+         const auto branch = upstreamMerge.startsWith(headsPrefix) ? upstreamMerge.mid(headsPrefix.length())
+                                                                   : upstreamMerge;
+
+         state->upstream = upstreamRemote == QLatin1String(".") ? branch : QString("%1/%2").arg(upstreamRemote, branch);
+      }
+   }
+
+   for (auto i = 0U; i < sizeof(OPERATION_FILES) / sizeof(OPERATION_FILES[0]); ++i)
+   {
+      if (QFileInfo::exists(mGit->getGitDir() + QLatin1Char('/') + QLatin1String(OPERATION_FILES[i])))
+      {
+         state->operation = OPERATIONS[i];
+         break;
+      }
+   }
+
+   const auto currentBranch = state->currentBranch;
+
+   std::atomic_store(&mState, std::shared_ptr<const RepoState>(std::move(state)));
+
+   // The watcher belongs to the thread of the object.
+   QMetaObject::invokeMethod(
+       this, [this, currentBranch]() { watchBranch(currentBranch); }, Qt::QueuedConnection);
+}
+
+QVector<qint64> GitRepoState::readStamp(const QString &currentBranch) const
+{
+   const auto gitDir = mGit->getGitDir();
+   const auto commonDir = mGit->getCommonDir();
+
+   QVector<qint64> stamp { modificationTime(gitDir + "/HEAD"),
+                           modificationTime(commonDir + "/packed-refs"),
+                           modificationTime(commonDir + "/config"),
+                           modificationTime(commonDir + "/refs/heads/" + currentBranch) };
+
+   for (const auto file : OPERATION_FILES)
+      stamp.append(modificationTime(gitDir + QLatin1Char('/') + QLatin1String(file)));
+
+   return stamp;
+}
+
+void GitRepoState::onPathChanged()
+{
+   mChangesTimer->start();
+}
+
+void GitRepoState::onChangesTimeout()
+{
+   QMutexLocker lock(&mGitMutex);
+
+   // The directories change for many other reasons, like the index, so the state files are checked first.
+   const auto current = std::atomic_load(&mState);
+
+   if (mGit && current && readStamp(current->currentBranch) != current->stamp)
+      readState();
+}
+
+void GitRepoState::watchBranch(const QString &currentBranch)
+{
+   QMutexLocker lock(&mGitMutex);
+
+   // The branches with a slash in their name have their reference in a subdirectory.
+   if (!mGit || !mWatcher || !currentBranch.contains(QLatin1Char('/')))
+      return;
+
+   const auto dir = QFileInfo(mGit->getCommonDir() + "/refs/heads/" + currentBranch).path();
+
+   if (QFileInfo(dir).isDir() && !mWatcher->directories().contains(dir))
+      mWatcher->addPath(dir);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class GitBase;
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * @brief The RepoState struct is a snapshot of where the repository is: the commit and the branch of HEAD, the
+ * upstream of the branch, the operation in progress and the caches git status can use. It's never modified once it's
+ * published.
+ */
+struct RepoState
+{
+   enum class Operation
+   {
+      None,
+      Merge,
+      CherryPick,
+      Revert,
+      Rebase
+   };
+
+   QString head;
+   QString currentBranch;
+   QString upstream;
+   Operation operation = Operation::None;
+   bool untrackedCache = false;
+   QString fsmonitor;
+   QVector<qint64> stamp;
+
+   bool isDetached() const { return currentBranch.isEmpty() || currentBranch == QLatin1String("HEAD"); }
+};
+
+/**
+ * @brief The GitRepoState class keeps the RepoState of a repository. It's refreshed when HEAD, the references, the
+ * config or the state files of an operation change, so the painters and the models read it without running git.
+ *
+ * The snapshot is swapped atomically: readers of any thread get a consistent state without taking a lock. The object
+ * lives in the main thread, whichever thread creates it.
+ */
+class GitRepoState : public QObject
+{
+   Q_OBJECT
+
+public:
+   explicit GitRepoState(const GitBase *git);
+
+   /**
+    * @brief state Returns the current snapshot. It's loaded the first time if it wasn't before.
+    */
+   std::shared_ptr<const RepoState> state();
+
+   /**
+    * @brief refresh Reads the state again. It's called when the repository is changed through GitQlient, so the new
+    * state is there before the file system notifies it.
+    */
+   void refresh();
+
+   /**
+    * @brief detach Forgets the GitBase before it's destroyed. It waits for a refresh in progress, and the pending
+    * notifications do nothing afterwards, so the object can be deleted later in its own thread.
+    */
+   void detach();
+
+private:
+   // Guards mGit, that is reset by detach() from the thread that destroys the GitBase.
+   QMutex mGitMutex;
+   const GitBase *mGit = nullptr;
+   QFileSystemWatcher *mWatcher = nullptr;
+   QTimer *mChangesTimer = nullptr;
+   std::shared_ptr<const RepoState> mState;
+
+   void startWatching();
+   void readState();
+   QVector<qint64> readStamp(const QString &currentBranch) const;
+   void onPathChanged();
+   void onChangesTimeout();
+   void watchBranch(const QString &currentBranch);
+};
@@ -0,0 +1,373 @@
+#include "GitRepoWatcher.h"
+
+#include <GitBase.h>
+#include <GitQlientSettings.h>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QTimer>
+
+#ifdef Q_OS_LINUX
+#   include <QSocketNotifier>
+
+#   include <sys/inotify.h>
+#   include <unistd.h>
+#else
+#   include <QDateTime>
+#   include <QFileSystemWatcher>
+#endif
+
+#include <QLogger.h>
+
+#include <algorithm>
+
+using namespace QLogger;
+
+namespace
+{
+// Time the changes are gathered before they are notified. It isn't restarted, so a long burst notifies as it goes.
+const int CHANGES_DELAY_MS = 100;
+
+// Time between the checks of the whole working tree when not every change is reported.
+const int FULL_REFRESH_MS = 15000;
+
+#ifdef Q_OS_LINUX
+const uint32_t WORKING_TREE_EVENTS
+    = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+// Git replaces the index and HEAD through a rename.
+const uint32_t GIT_DIR_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+QStringList splitEntries(const QString &output)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   return output.split(QChar::Null, Qt::SkipEmptyParts);
+#else
+   return output.split(QChar::Null, QString::SkipEmptyParts);
+#endif
+}
+
+bool isGitDir(const QString &path)
+{
+   return path.endsWith("/.git") || path.contains("/.git/");
+}
+}
+
+GitRepoWatcher::GitRepoWatcher(const QSharedPointer<GitBase> &git, QObject *parent)
+   : QObject(parent)
+   , mGit(git)
+   , mChangesTimer(new QTimer(this))
+   , mFullRefreshTimer(new QTimer(this))
+   , mMaxDirectories(GitQlientSettings().globalValue("maxWatchedDirectories", 4096).toInt())
+{
+   mChangesTimer->setSingleShot(true);
+   mChangesTimer->setInterval(CHANGES_DELAY_MS);
+
+   connect(mChangesTimer, &QTimer::timeout, this, &GitRepoWatcher::emitChanges);
+
+   mFullRefreshTimer->setInterval(FULL_REFRESH_MS);
+
+   connect(mFullRefreshTimer, &QTimer::timeout, this, [this]() { notifyChange(); });
+
+#ifndef Q_OS_LINUX
+   mWatcher = new QFileSystemWatcher(this);
+
+   connect(mWatcher, &QFileSystemWatcher::directoryChanged, this, &GitRepoWatcher::onDirectoryChanged);
+#endif
+}
+
+GitRepoWatcher::~GitRepoWatcher()
+{
+#ifdef Q_OS_LINUX
+   if (mInotify != -1)
+      close(mInotify);
+#endif
+}
+
+void GitRepoWatcher::start()
+{
+   const auto workingDir = mGit->getWorkingDir();
+   const auto gitDir = mGit->getGitDir();
+
+   QLog_Debug("Git", QString("Watching the changes in {%1}").arg(workingDir));
+
+#ifdef Q_OS_LINUX
+   mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+   if (mInotify == -1)
+   {
+      QLog_Warning("Git", QString("The changes in {%1} can't be watched.").arg(workingDir));
+      mFullRefreshTimer->start();
+      return;
+   }
+
+   mNotifier = new QSocketNotifier(mInotify, QSocketNotifier::Read, this);
+   connect(mNotifier, &QSocketNotifier::activated, this, &GitRepoWatcher::readEvents);
+
+   mGitDirWatch = inotify_add_watch(mInotify, QFile::encodeName(gitDir).constData(), GIT_DIR_EVENTS);
+#else
+   // The files written in place aren't always reported.
+   mFullRefreshTimer->start();
+
+   mGitDirStamp = readGitDirStamp();
+   mWatcher->addPath(gitDir);
+#endif
+
+   const auto ret = mGit->run("git ls-files -z --cached --others --exclude-standard --directory");
+
+   if (!ret.success)
+      return;
+
+   QSet<QString> directories { QString() };
+   QStringList untrackedDirectories;
+
+   for (const auto &entry : splitEntries(ret.output))
+   {
+      // The untracked directories are listed once instead of their files.
+      if (entry.endsWith('/'))
+      {
+         untrackedDirectories.append(workingDir + '/' + entry.left(entry.length() - 1));
+         continue;
+      }
+
+      // When a directory is already there, so are its parents.
+      for (auto end = entry.lastIndexOf('/'); end > 0; end = entry.lastIndexOf('/', end - 1))
+      {
+         const auto directory = entry.left(end);
+
+         if (directories.contains(directory))
+            break;
+
+         directories.insert(directory);
+      }
+   }
+
+   // The shallow directories are watched first, so they are the ones kept if there are too many.
+   auto sortedDirectories = directories.values();
+   std::sort(sortedDirectories.begin(), sortedDirectories.end(), [](const QString &left, const QString &right) {
+      return left.count('/') < right.count('/') || (left.count('/') == right.count('/') && left < right);
+   });
+
+   for (const auto &directory : qAsConst(sortedDirectories))
+      watchDirectory(directory.isEmpty() ? workingDir : workingDir + '/' + directory);
+
+   for (const auto &directory : qAsConst(untrackedDirectories))
+      watchTree(directory);
+}
+
+bool GitRepoWatcher::watchDirectory(const QString &dir)
+{
+   if (mDirectories.contains(dir))
+      return true;
+
+   if (mDirectories.count() >= mMaxDirectories)
+   {
+      if (!mLimitReached)
+      {
+         mLimitReached = true;
+         mFullRefreshTimer->start();
+
+         QLog_Warning("Git",
+                      QString("The limit of %1 watched directories was reached in {%2}. The whole working tree is "
+                              "checked on every change and every %3 seconds.")
+                          .arg(QString::number(mMaxDirectories), mGit->getWorkingDir(),
+                               QString::number(FULL_REFRESH_MS / 1000)));
+      }
+
+      return false;
+   }
+
+#ifdef Q_OS_LINUX
+   const auto watch = inotify_add_watch(mInotify, QFile::encodeName(dir).constData(), WORKING_TREE_EVENTS);
+
+   if (watch == -1)
+      return false;
+
+   mWatches.insert(watch, dir);
+#else
+   if (!mWatcher->addPath(dir))
+      return false;
+#endif
+
+   mDirectories.insert(dir);
+
+   return true;
+}
+
+void GitRepoWatcher::watchTree(const QString &dir)
+{
+   if (!watchDirectory(dir))
+      return;
+
+   QDirIterator it(dir, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks,
+                   QDirIterator::Subdirectories);
+
+   while (it.hasNext())
+   {
+      if (const auto subdir = it.next(); !isGitDir(subdir) && !watchDirectory(subdir))
+         break;
+   }
+}
+
+void GitRepoWatcher::watchNewDirectories(const QStringList &dirs)
+{
+   const QDir workingDir(mGit->getWorkingDir());
+   QStringList paths;
+
+   for (const auto &dir : dirs)
+      paths.append(QString("\"%1\"").arg(workingDir.relativeFilePath(dir)));
+
+   // The ignored directories are listed as a whole, with a slash at the end.
+   const auto ret = mGit->run(
+       QString("git ls-files -z --others --ignored --exclude-standard --directory -- %1").arg(paths.join(' ')));
+   const auto ignored = ret.success ? splitEntries(ret.output) : QStringList();
+
+   for (const auto &dir : dirs)
+   {
+      if (!ignored.contains(workingDir.relativeFilePath(dir) + '/'))
+         watchTree(dir);
+   }
+}
+
+void GitRepoWatcher::ignoreGitDirChanges()
+{
+#ifdef Q_OS_LINUX
+   if (mInotify == -1)
+      return;
+
+   // The events are already queued, since git has finished.
+   mIgnoreGitDir = true;
+   readEvents();
+   mIgnoreGitDir = false;
+#else
+   mGitDirStamp = readGitDirStamp();
+#endif
+}
+
+void GitRepoWatcher::notifyChange(const QString &dir)
+{
+   // The changes in the git directory, or in the root of the working tree, need the whole WIP. So does any change
+   // when some directories aren't watched, since the changes in those aren't reported.
+   if (mLimitReached || dir.isEmpty() || dir == mGit->getWorkingDir())
+      mFullUpdate = true;
+   else
+      mChangedDirectories.insert(QDir(mGit->getWorkingDir()).relativeFilePath(dir));
+
+   if (!mChangesTimer->isActive())
+      mChangesTimer->start();
+}
+
+void GitRepoWatcher::emitChanges()
+{
+   const auto directories = mFullUpdate ? QStringList() : mChangedDirectories.values();
+
+   mFullUpdate = false;
+   mChangedDirectories.clear();
+
+   emit workingTreeChanged(directories);
+}
+
+#ifdef Q_OS_LINUX
+void GitRepoWatcher::readEvents()
+{
+   alignas(inotify_event) char buffer[16384];
+   auto fullUpdate = false;
+   QSet<QString> changedDirectories;
+   QStringList newDirectories;
+   ssize_t length = 0;
+
+   while ((length = read(mInotify, buffer, sizeof(buffer))) > 0)
+   {
+      for (auto offset = 0L; offset < length;)
+      {
+         const auto event = reinterpret_cast<const inotify_event *>(buffer + offset);
+         const auto name = event->len > 0 ? QFile::decodeName(event->name) : QString();
+
+         offset += sizeof(inotify_event) + event->len;
+
+         if (event->mask & IN_Q_OVERFLOW)
+         {
+            // Some events were lost, so it's not known what changed.
+            fullUpdate = true;
+         }
+         else if (event->mask & IN_IGNORED)
+         {
+            // The directory was removed.
+            mDirectories.remove(mWatches.take(event->wd));
+         }
+         else if (event->wd == mGitDirWatch)
+         {
+            // Only the index and HEAD change the WIP. The rest are the files of the operations and the locks.
+            fullUpdate |= !mIgnoreGitDir && (name == QLatin1String("index") || name == QLatin1String("HEAD"));
+         }
+         else if (const auto dir = mWatches.value(event->wd); !dir.isEmpty() && name != QLatin1String(".git"))
+         {
+            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+               newDirectories.append(dir + '/' + name);
+
+            changedDirectories.insert(dir);
+         }
+      }
+   }
+
+   if (!newDirectories.isEmpty())
+      watchNewDirectories(newDirectories);
+
+   if (fullUpdate)
+      notifyChange();
+
+   for (const auto &dir : qAsConst(changedDirectories))
+      notifyChange(dir);
+}
+#else
+QVector<qint64> GitRepoWatcher::readGitDirStamp() const
+{
+   const auto gitDir = mGit->getGitDir();
+   QVector<qint64> stamp;
+
+   for (const auto &file : { QString("%1/index").arg(gitDir), QString("%1/HEAD").arg(gitDir) })
+   {
+      const QFileInfo info(file);
+      stamp.append(info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1);
+   }
+
+   return stamp;
+}
+
+void GitRepoWatcher::onDirectoryChanged(const QString &dir)
+{
+   if (dir == mGit->getGitDir())
+   {
+      // Only the index and HEAD change the WIP. The rest are the files of the operations and the locks.
+      if (const auto stamp = readGitDirStamp(); stamp != mGitDirStamp)
+      {
+         mGitDirStamp = stamp;
+         notifyChange();
+      }
+
+      return;
+   }
+
+   if (!QFileInfo(dir).isDir())
+      mDirectories.remove(dir);
+   else
+   {
+      QStringList newDirectories;
+      const auto entries
+          = QDir(dir).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks);
+
+      for (const auto &entry : entries)
+      {
+         if (const auto path = entry.absoluteFilePath(); !mDirectories.contains(path) && !isGitDir(path))
+            newDirectories.append(path);
+      }
+
+      if (!newDirectories.isEmpty())
+         watchNewDirectories(newDirectories);
+   }
+
+   notifyChange(dir);
+}
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class GitBase;
+class QFileSystemWatcher;
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * @brief The GitRepoWatcher class notifies when the working tree or the index of a repository change, so the WIP is
+ * only updated when there is something new.
+ *
+ * It watches the directories of the working tree that aren't ignored, the new ones included, and the git directory.
+ * The directories that changed are notified, so only those are listed again.
+ * On Linux it uses inotify directly, since the directory watches of QFileSystemWatcher don't report the files that
+ * are written in place. The changes are gathered for a short time and notified once.
+ *
+ * Elsewhere, or when there are more directories than the limit, the whole working tree is also checked every few
+ * seconds, since some changes aren't reported. Past the limit, every change updates the whole working tree too.
+ */
+class GitRepoWatcher : public QObject
+{
+   Q_OBJECT
+
+signals:
+   /**
+    * @brief workingTreeChanged Signal triggered when the files, the index or HEAD changed.
+    *
+    * @param directories The directories where the files changed, relative to the working tree. It's empty when the
+    * whole working tree has to be checked, like when the index or HEAD changed.
+    */
+   void workingTreeChanged(const QStringList &directories);
+
+public:
+   explicit GitRepoWatcher(const QSharedPointer<GitBase> &git, QObject *parent = nullptr);
+   ~GitRepoWatcher() override;
+
+   /**
+    * @brief start Starts watching the repository. The directories are taken from git, so the ignored ones are left
+    * out.
+    */
+   void start();
+
+   /**
+    * @brief ignoreGitDirChanges Drops the changes of the index and HEAD that are pending. It's called after listing
+    * the WIP, since git status can save the untracked cache and the fsmonitor token in the index.
+    */
+   void ignoreGitDirChanges();
+
+private:
+   QSharedPointer<GitBase> mGit;
+   QTimer *mChangesTimer = nullptr;
+   QTimer *mFullRefreshTimer = nullptr;
+   int mMaxDirectories = 0;
+   bool mLimitReached = false;
+   bool mFullUpdate = false;
+   QSet<QString> mDirectories;
+   QSet<QString> mChangedDirectories;
+#ifdef Q_OS_LINUX
+   int mInotify = -1;
+   int mGitDirWatch = -1;
+   bool mIgnoreGitDir = false;
+   QSocketNotifier *mNotifier = nullptr;
+   QHash<int, QString> mWatches;
+
+   void readEvents();
+#else
+   QFileSystemWatcher *mWatcher = nullptr;
+   QVector<qint64> mGitDirStamp;
+
+   QVector<qint64> readGitDirStamp() const;
+   void onDirectoryChanged(const QString &dir);
+#endif
+
+   bool watchDirectory(const QString &dir);
+   void watchTree(const QString &dir);
+   void watchNewDirectories(const QStringList &dirs);
+   void notifyChange(const QString &dir = QString());
+   void emitChanges();
+};
@@ -0,0 +1,353 @@
+#include "GitScheduler.h"
+
+#include <GitAsyncProcess.h>
+#include <GitQlientSettings.h>
+
+#include <QFutureWatcher>
+#include <QSet>
+#include <QThread>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+// Processes of the same repository that can run at the same time.
+static const int MAX_PROCESSES_PER_REPO = 4;
+
+// Time a queued command waits before it's promoted to the next priority class.
+static const int AGING_MS = 2000;
+
+GitScheduler *GitScheduler::getInstance()
+{
+   static GitScheduler scheduler;
+
+   return &scheduler;
+}
+
+GitScheduler::GitScheduler()
+   : mMaxProcesses(
+       qMax(1, GitQlientSettings().globalValue("maxGitProcesses", QThread::idealThreadCount()).toInt()))
+{
+}
+
+QFuture<GitExecResult> GitScheduler::run(const QString &workingDir, const QString &command, Priority priority)
+{
+   const auto key = workingDir + QLatin1Char('\n') + command;
+   const auto coalesce = isReadOnly(command);
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      if (const auto inFlight = mAsyncInFlight.value(key); coalesce && inFlight)
+      {
+         QLog_Trace("Git", QString("Git command {%1} coalesced with the one in flight.").arg(command));
+         return subscribe(inFlight);
+      }
+   }
+
+   auto request = QSharedPointer<Request>::create();
+   request->workingDir = workingDir;
+   request->command = command;
+   request->key = coalesce ? key : QString();
+   request->priority = priority;
+   request->queued.start();
+   request->thread = QThread::currentThread();
+
+   // The process belongs to the calling thread, that runs it when the scheduler starts the command.
+   request->process = new GitAsyncProcess(workingDir);
+
+   QObject::connect(request->process, &GitAsyncProcess::signalDataReady, request->process,
+                    [this, request](GitExecResult result) { finish(request, result); });
+
+   QFuture<GitExecResult> future;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      request->id = ++mLastId;
+      future = subscribe(request);
+      mQueue.append(request);
+      ++mAsyncByThread[request->thread];
+
+      if (coalesce)
+         mAsyncInFlight.insert(key, request);
+   }
+
+   dispatch();
+
+   return future;
+}
+
+QFuture<GitExecResult> GitScheduler::subscribe(const QSharedPointer<Request> &request)
+{
+   QFutureInterface<GitExecResult> promise;
+   promise.reportStarted();
+
+   request->promises.append(promise);
+   ++request->waiting;
+
+   // The watcher lives in the thread of the requester, that has an event loop.
+   const auto watcher = new QFutureWatcher<GitExecResult>();
+
+   QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, &QObject::deleteLater);
+   QObject::connect(watcher, &QFutureWatcherBase::canceled, watcher, [this, request, promise]() mutable {
+      promise.reportFinished();
+      unsubscribe(request);
+   });
+
+   watcher->setFuture(promise.future());
+
+   return promise.future();
+}
+
+void GitScheduler::unsubscribe(const QSharedPointer<Request> &request)
+{
+   {
+      QMutexLocker lock(&mMutex);
+
+      // The command keeps running while another requester waits for it.
+      if (--request->waiting > 0)
+         return;
+
+      if (!request->key.isEmpty() && mAsyncInFlight.value(request->key) == request)
+         mAsyncInFlight.remove(request->key);
+   }
+
+   cancel(request);
+}
+
+GitExecResult GitScheduler::runSync(const QString &workingDir, const QString &command,
+                                    const std::function<GitExecResult()> &runner)
+{
+   const auto key = workingDir + QLatin1Char('\n') + command;
+   const auto coalesce = isReadOnly(command);
+   QFutureInterface<GitExecResult> promise;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      if (const auto inFlight = mSyncInFlight.constFind(key); coalesce && inFlight != mSyncInFlight.cend())
+      {
+         auto future = inFlight.value();
+         lock.unlock();
+
+         QLog_Trace("Git", QString("Waiting for the git command {%1} in flight.").arg(command));
+
+         future.waitForFinished();
+
+         return future.resultCount() > 0 ? future.result() : GitExecResult();
+      }
+
+      // The asynchronous commands of this thread only finish when it returns to its event loop, it can't wait for them.
+      if (!mAsyncByThread.contains(QThread::currentThread()))
+      {
+         while (mRunningByRepo.value(workingDir) >= MAX_PROCESSES_PER_REPO)
+            mSlotReleased.wait(&mMutex);
+      }
+
+      promise.reportStarted();
+
+      if (coalesce)
+         mSyncInFlight.insert(key, promise.future());
+
+      ++mRunning;
+      ++mRunningByRepo[workingDir];
+   }
+
+   const auto result = runner();
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      if (coalesce)
+         mSyncInFlight.remove(key);
+
+      release(workingDir);
+   }
+
+   promise.reportResult(result);
+   promise.reportFinished();
+
+   dispatch();
+
+   return result;
+}
+
+void GitScheduler::dispatch()
+{
+   QList<QSharedPointer<Request>> ready;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      while (mRunning < mMaxProcesses && !mQueue.isEmpty())
+      {
+         auto best = -1;
+         auto bestPriority = 0LL;
+
+         for (auto i = 0; i < mQueue.count(); ++i)
+         {
+            const auto &request = mQueue.at(i);
+
+            if (mRunningByRepo.value(request->workingDir) >= MAX_PROCESSES_PER_REPO)
+               continue;
+
+            // The queue is in arrival order, so the oldest request wins between the same priorities.
+            const auto priority = static_cast<qint64>(request->priority) - request->queued.elapsed() / AGING_MS;
+
+            if (best == -1 || priority < bestPriority)
+            {
+               best = i;
+               bestPriority = priority;
+            }
+         }
+
+         if (best == -1)
+            break;
+
+         const auto request = mQueue.takeAt(best);
+
+         ++mRunning;
+         ++mRunningByRepo[request->workingDir];
+
+         ready.append(request);
+      }
+   }
+
+   for (const auto &request : qAsConst(ready))
+      start(request);
+}
+
+void GitScheduler::start(const QSharedPointer<Request> &request)
+{
+   if (!request->process)
+   {
+      finish(request, { false, QString("The process of {%1} was destroyed.").arg(request->command) });
+      return;
+   }
+
+   QMetaObject::invokeMethod(
+       request->process,
+       [this, request]() {
+          auto canceled = false;
+
+          {
+             QMutexLocker lock(&mMutex);
+             canceled = request->waiting == 0;
+          }
+
+          if (canceled)
+          {
+             finish(request, {});
+             request->process->deleteLater();
+          }
+          else if (!request->process->run(request->command).success)
+          {
+             finish(request, { false, QString("The command {%1} couldn't be started.").arg(request->command) });
+             request->process->deleteLater();
+          }
+       },
+       Qt::QueuedConnection);
+}
+
+void GitScheduler::finish(const QSharedPointer<Request> &request, const GitExecResult &result)
+{
+   QList<QFutureInterface<GitExecResult>> promises;
+   auto canceled = false;
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      release(request->workingDir);
+      releaseThread(request->thread);
+
+      if (!request->key.isEmpty() && mAsyncInFlight.value(request->key) == request)
+         mAsyncInFlight.remove(request->key);
+
+      promises = request->promises;
+      canceled = request->waiting == 0;
+   }
+
+   if (!result.success && !canceled)
+      QLog_Warning("Git", QString("Git command {%1} has errors:\n%2").arg(request->command, result.output));
+
+   // The promises that were canceled are already finished and ignore the result.
+   for (auto &promise : promises)
+   {
+      promise.reportResult(result);
+      promise.reportFinished();
+   }
+
+   dispatch();
+}
+
+void GitScheduler::cancel(const QSharedPointer<Request> &request)
+{
+   QLog_Info("Git", QString("Git command {%1} canceled.").arg(request->command));
+
+   {
+      QMutexLocker lock(&mMutex);
+
+      if (!mQueue.removeOne(request))
+      {
+         lock.unlock();
+
+         // It's running or about to start, in which case it's finished when it's started.
+         if (request->process && request->process->state() != QProcess::NotRunning)
+            request->process->kill();
+
+         return;
+      }
+
+      releaseThread(request->thread);
+   }
+
+   if (request->process)
+      request->process->deleteLater();
+}
+
+void GitScheduler::release(const QString &workingDir)
+{
+   --mRunning;
+
+   if (auto &running = mRunningByRepo[workingDir]; --running <= 0)
+      mRunningByRepo.remove(workingDir);
+
+   mSlotReleased.wakeAll();
+}
+
+void GitScheduler::releaseThread(QThread *thread)
+{
+   if (auto &pending = mAsyncByThread[thread]; --pending <= 0)
+      mAsyncByThread.remove(thread);
+}
+
+bool GitScheduler::isReadOnly(const QString &command)
+{
+   static const QSet<QString> readOnlyCommands {
+      "annotate", "blame",     "cat-file", "diff", "diff-index", "diff-tree", "for-each-ref", "log",
+      "ls-files", "ls-remote", "ls-tree",  "rev-list", "rev-parse", "show", "show-ref",     "status"
+   };
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+   const auto arguments = command.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+#else
+   const auto arguments = command.split(QLatin1Char(' '), QString::SkipEmptyParts);
+#endif
+
+   // The global options of git go before the command.
+   for (auto i = 1; i < arguments.count(); ++i)
+   {
+      if (!arguments.at(i).startsWith(QLatin1Char('-')))
+      {
+         const auto &gitCommand = arguments.at(i);
+
+         if (gitCommand == QLatin1String("config"))
+            return command.contains(QLatin1String("--get")) || command.contains(QLatin1String("--list"));
+
+         return readOnlyCommands.contains(gitCommand);
+      }
+   }
+
+   return false;
+}
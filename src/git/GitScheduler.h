@@ -0,0 +1,123 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <GitExecResult.h>
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QWaitCondition>
+
+#include <functional>
+
+class GitAsyncProcess;
+class QThread;
+
+/**
+ * @brief The GitScheduler class is in front of the git processes of all the repositories. It limits how many of them
+ * run at the same time, globally and per repository, and starts the queued commands by priority. A command that has
+ * waited long enough is promoted, so the background work is never starved by the interactive one.
+ *
+ * Identical read-only commands of the same repository that are in flight at the same time are run only once. Every
+ * requester gets its own future with the same result, and the command is only canceled when all of them cancel it.
+ *
+ * The synchronous commands are not queued by priority. They wait for a free slot of their repository, unless their
+ * thread owns asynchronous commands that haven't finished: those only finish when the thread returns to its event
+ * loop, so waiting could deadlock it. In that case they run straight away and are only counted.
+ */
+class GitScheduler
+{
+public:
+   enum class Priority
+   {
+      Interactive,
+      Visible,
+      Background
+   };
+
+   static GitScheduler *getInstance();
+
+   /**
+    * @brief run Queues a command that runs in the calling thread, that needs an event loop.
+    *
+    * @param workingDir The working directory of the repository.
+    * @param command The git command.
+    * @param priority The priority class of the command.
+    * @return The future with the result, one per requester. Canceling it removes the command from the queue or kills
+    * it once no other requester waits for it.
+    */
+   QFuture<GitExecResult> run(const QString &workingDir, const QString &command, Priority priority);
+
+   /**
+    * @brief runSync Runs a command synchronously through @p runner, or waits for the same command if it's already
+    * running in another thread. It blocks while the repository has no free slot, see the class description.
+    */
+   GitExecResult runSync(const QString &workingDir, const QString &command,
+                         const std::function<GitExecResult()> &runner);
+
+private:
+   struct Request
+   {
+      quint64 id = 0;
+      QString workingDir;
+      QString command;
+      QString key;
+      Priority priority = Priority::Interactive;
+      QElapsedTimer queued;
+      // One promise per requester. The ones that are not canceled yet are counted in waiting.
+      QList<QFutureInterface<GitExecResult>> promises;
+      int waiting = 0;
+      QThread *thread = nullptr;
+      QPointer<GitAsyncProcess> process;
+   };
+
+   QMutex mMutex;
+   QWaitCondition mSlotReleased;
+   quint64 mLastId = 0;
+   int mMaxProcesses = 1;
+   int mRunning = 0;
+   QHash<QString, int> mRunningByRepo;
+   QHash<QThread *, int> mAsyncByThread;
+   QList<QSharedPointer<Request>> mQueue;
+   QHash<QString, QSharedPointer<Request>> mAsyncInFlight;
+   QHash<QString, QFuture<GitExecResult>> mSyncInFlight;
+
+   GitScheduler();
+
+   QFuture<GitExecResult> subscribe(const QSharedPointer<Request> &request);
+   void unsubscribe(const QSharedPointer<Request> &request);
+   void dispatch();
+   void start(const QSharedPointer<Request> &request);
+   void finish(const QSharedPointer<Request> &request, const GitExecResult &result);
+   void cancel(const QSharedPointer<Request> &request);
+   void release(const QString &workingDir);
+   void releaseThread(QThread *thread);
+   static bool isReadOnly(const QString &command);
+};
@@ -1,6 +1,6 @@
-#include <GitAsyncProcess.h>
 #include <GitBase.h>
 #include <GitCache.h>
+#include <GitFuture.h>
 #include <GitTags.h>
 #include <QLogger.h>
 
@@ -27,7 +27,7 @@ GitTags::GitTags(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<Gi
 {
 }
 
-bool GitTags::getRemoteTags() const
+bool GitTags::getRemoteTags()
 {
    if (!mCache.get())
    {
@@ -41,12 +41,11 @@ bool GitTags::getRemoteTags() const
 
    QLog_Trace("Git", QString("Getting remote tags: {%1}").arg(cmd));
 
-   const auto p = new GitAsyncProcess(mGitBase->getWorkingDir());
-   connect(p, &GitAsyncProcess::signalDataReady, this, &GitTags::onRemoteTagsRecieved);
+   // The remote tags only decorate the graph, so they wait for the commands the user is waiting for.
+   const auto future = mGitBase->runAsync(cmd, GitScheduler::Priority::Background);
+   GitFuture::then(future, this, [this](const GitExecResult &ret) { onRemoteTagsRecieved(ret); });
 
-   const auto ret = p->run(cmd);
-
-   return ret.success;
+   return !future.isCanceled();
 }
 
 GitExecResult GitTags::addTag(const QString &tagName, const QString &tagMessage, const QString &sha)
@@ -102,18 +101,19 @@ GitExecResult GitTags::pushTag(const QString &tagName)
    return ret;
 }
 
-GitExecResult GitTags::getTagCommit(const QString &tagName)
+QFuture<GitExecResult> GitTags::pushTagAsync(const QString &tagName)
 {
-   QLog_Debug("Git", QString("Getting the commit of a tag: {%1}").arg(tagName));
+   QLog_Debug("Git", QString("Pushing a tag asynchronously: {%1}").arg(tagName));
 
-   const auto cmd = QString("git rev-list -n 1 %1").arg(tagName);
-
-   QLog_Trace("Git", QString("Getting the commit of a tag: {%1}").arg(cmd));
+   return mGitBase->runAsync(QString("git push origin %1").arg(tagName));
+}
 
-   const auto ret = mGitBase->run(cmd);
-   const auto output = ret.output.trimmed();
+GitExecResult GitTags::getTagCommit(const QString &tagName)
+{
+   QLog_Debug("Git", QString("Getting the commit of a tag: {%1}").arg(tagName));
 
-   return qMakePair(ret.success, output);
+   // Annotated tags point to a tag object, the commit is the one it points to.
+   return mGitBase->resolve(QString("%1^{commit}").arg(tagName));
 }
 
 void GitTags::onRemoteTagsRecieved(GitExecResult result)
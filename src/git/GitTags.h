@@ -25,6 +25,7 @@
 
 #include <GitExecResult.h>
 
+#include <QFuture>
 #include <QSharedPointer>
 #include <QString>
 #include <QVector>
@@ -40,10 +41,11 @@ public:
    explicit GitTags(const QSharedPointer<GitBase> &gitBase);
    explicit GitTags(const QSharedPointer<GitBase> &gitBase, const QSharedPointer<GitCache> &cache);
 
-   bool getRemoteTags() const;
+   bool getRemoteTags();
    GitExecResult addTag(const QString &tagName, const QString &tagMessage, const QString &sha);
    GitExecResult removeTag(const QString &tagName, bool remote);
    GitExecResult pushTag(const QString &tagName);
+   QFuture<GitExecResult> pushTagAsync(const QString &tagName);
    GitExecResult getTagCommit(const QString &tagName);
 
 private:
@@ -1,77 +1,263 @@
 #include "GitWip.h"
 
+#include <CommitInfo.h>
 #include <GitBase.h>
 #include <GitCache.h>
+#include <GitQlientSettings.h>
+#include <PathTable.h>
 
 #include <QLogger.h>
 
-#include <QFile>
+#include <algorithm>
 
 using namespace QLogger;
 
-GitWip::GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
-   : mGit(git)
-   , mCache(cache)
+namespace
 {
+// Returns the position after the field @p count of the record, where the next field starts.
+int skipFields(const QString &record, int count)
+{
+   auto position = 0;
+
+   for (auto i = 0; i < count && position != -1; ++i)
+   {
+      position = record.indexOf(QLatin1Char(' '), position);
+
+      if (position != -1)
+         ++position;
+   }
+
+   return position;
 }
 
-QVector<QString> GitWip::getUntrackedFiles() const
+// Status of a file from the two letters of git status: the change in the index and the change in the work tree.
+int fileStatus(QChar index, QChar workTree)
 {
-   QLog_Debug("Git", QString("Executing getUntrackedFiles."));
+   int status = RevisionFiles::MODIFIED;
 
-   auto runCmd = QString("git ls-files --others");
-   const auto exFile = QString("info/exclude");
-   const auto path = QString("%1/%2").arg(mGit->getGitDir(), exFile);
+   if (index == QLatin1Char('A') || index == QLatin1Char('R') || index == QLatin1Char('C')
+       || workTree == QLatin1Char('A'))
+      status = RevisionFiles::NEW;
+   else if (index == QLatin1Char('D') || workTree == QLatin1Char('D'))
+      status = RevisionFiles::DELETED;
 
-   if (QFile::exists(path))
-      runCmd.append(QString(" --exclude-from=$%1$").arg(path));
+   // Files with changes both in the index and in the work tree are shown in both lists.
+   if (index != QLatin1Char('.'))
+      status |= workTree == QLatin1Char('.') ? RevisionFiles::IN_INDEX : RevisionFiles::PARTIALLY_CACHED;
 
-   runCmd.append(QString(" --exclude-per-directory=$%1$").arg(".gitignore"));
+   return status;
+}
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-   const auto ret = mGit->run(runCmd).output.split('\n', Qt::SkipEmptyParts).toVector();
-#else
-   const auto ret = mGit->run(runCmd).output.split('\n', QString::SkipEmptyParts).toVector();
-#endif
+void addFile(RevisionFiles &files, const QString &file, int status)
+{
+   if (const auto position = files.indexOf(file); position != -1)
+   {
+      files.appendStatus(position, static_cast<RevisionFiles::StatusFlag>(status));
+      return;
+   }
 
-   return ret;
+   files.appendFile(file);
+   files.setStatus(static_cast<RevisionFiles::StatusFlag>(status));
+}
+}
+
+GitWip::GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache)
+   : mGit(git)
+   , mCache(cache)
+{
 }
 
 WipRevisionInfo GitWip::getWipInfo() const
 {
    QLog_Debug("Git", QString("Executing processWip."));
 
-   const auto ret = mGit->run("git rev-parse --revs-only HEAD");
+   const auto ret = mGit->run(statusCommand());
 
    if (ret.success)
+      return parseStatus(ret.output);
+
+   return {};
+}
+
+bool GitWip::updateWip(const QStringList &directories) const
+{
+   if (directories.isEmpty())
    {
-      QString diffIndex;
-      QString diffIndexCached;
+      if (const auto wipInfo = getWipInfo(); wipInfo.isValid())
+         return mCache->updateWipCommit(wipInfo);
+
+      return false;
+   }
+
+   QLog_Debug("Git", QString("Updating the WIP in {%1}.").arg(directories.join(", ")));
 
-      auto parentSha = ret.output.trimmed();
+   const auto ret = mGit->run(statusCommand(directories));
 
-      if (parentSha.isEmpty())
-         parentSha = CommitInfo::INIT_SHA;
+   if (!ret.success)
+      return false;
 
-      const auto ret3 = mGit->run(QString("git diff-index %1").arg(parentSha));
-      diffIndex = ret3.success ? ret3.output : QString();
+   const auto changes = parseStatus(ret.output);
 
-      const auto ret4 = mGit->run(QString("git diff-index --cached %1").arg(parentSha));
-      diffIndexCached = ret4.success ? ret4.output : QString();
+   // The rest of the WIP is only valid if it was listed from the same parent.
+   const auto previousFiles = changes.isValid() ? mCache->revisionFile(CommitInfo::ZERO_SHA, changes.parentSha)
+                                                : std::nullopt;
 
-      return { parentSha, diffIndex, diffIndexCached };
+   if (!previousFiles)
+      return updateWip();
+
+   // The files are matched with the directories through the ids of their paths.
+   const auto pathTable = PathTable::getInstance();
+   QVector<int> directoryIds;
+
+   for (const auto &directory : directories)
+   {
+      if (const auto id = pathTable->find(directory); id != PathTable::INVALID_ID)
+         directoryIds.append(id);
    }
 
-   return {};
+   const auto isChanged = [pathTable, &directoryIds](int pathId) {
+      return std::any_of(directoryIds.cbegin(), directoryIds.cend(),
+                         [pathTable, pathId](int directoryId) { return pathTable->isInside(pathId, directoryId); });
+   };
+
+   WipRevisionInfo wipInfo { changes.parentSha, RevisionFiles(), {} };
+
+   wipInfo.files.setOnlyModified(false);
+
+   for (auto i = 0; i < previousFiles->count(); ++i)
+   {
+      if (isChanged(previousFiles->getPathId(i)))
+         continue;
+
+      const auto &file = previousFiles->getFile(i);
+      const auto status = previousFiles->getStatus(i);
+
+      if (status & RevisionFiles::UNKNOWN)
+         wipInfo.untrackedFiles.append(file);
+
+      addFile(wipInfo.files, file, status);
+   }
+
+   for (auto i = 0; i < changes.files.count(); ++i)
+      addFile(wipInfo.files, changes.files.getFile(i), changes.files.getStatus(i));
+
+   wipInfo.untrackedFiles.append(changes.untrackedFiles);
+
+   return mCache->updateWipCommit(wipInfo);
+}
+
+QString GitWip::statusCommand(const QStringList &directories) const
+{
+   const auto repoState = mGit->getRepoState();
+   GitQlientSettings settings(mGit->getGitDir());
+   auto options = QString();
+   auto cachesEnabled = repoState->untrackedCache || !repoState->fsmonitor.isEmpty();
+
+   // The repository can opt in from GitQlient without changing its git config: FsMonitor is "true" for the daemon
+   // of git or the path of a hook.
+   if (const auto fsmonitor = settings.localValue("FsMonitor", "").toString();
+       repoState->fsmonitor.isEmpty() && !fsmonitor.isEmpty())
+   {
+      options.append(QString(" -c \"core.fsmonitor=%1\"").arg(fsmonitor));
+      cachesEnabled = true;
+   }
+
+   if (!repoState->untrackedCache && settings.localValue("UntrackedCache", false).toBool())
+   {
+      options.append(" -c core.untrackedCache=true");
+      cachesEnabled = true;
+   }
+
+   // Without the caches, the status must not take the index lock from other git commands that are running. With
+   // them, git saves the untracked cache and the fsmonitor token in the index, otherwise every status starts over.
+   if (!cachesEnabled)
+      options.append(" --no-optional-locks");
+
+   auto cmd = QString("git%1 status --porcelain=v2 -z --branch --untracked-files=all").arg(options);
+
+   if (!directories.isEmpty())
+   {
+      cmd.append(" --");
+
+      for (const auto &directory : directories)
+         cmd.append(QString(" \":(literal)%1/\"").arg(directory));
+   }
+
+   return cmd;
 }
 
-bool GitWip::updateWip() const
+WipRevisionInfo GitWip::parseStatus(const QString &status)
 {
-   const auto files = getUntrackedFiles();
-   mCache->setUntrackedFilesList(std::move(files));
+   WipRevisionInfo wipInfo;
+   const auto length = status.length();
+   auto start = 0;
+
+   wipInfo.files.setOnlyModified(false);
+
+   while (start < length)
+   {
+      auto end = status.indexOf(QChar::Null, start);
+
+      if (end == -1)
+         end = length;
+
+      const auto record = status.mid(start, end - start);
 
-   if (const auto wipInfo = getWipInfo(); wipInfo.isValid())
-      return mCache->updateWipCommit(wipInfo);
+      start = end + 1;
+
+      if (record.length() < 2)
+         continue;
+
+      switch (record.at(0).toLatin1())
+      {
+         case '#':
+            if (record.startsWith(QLatin1String("# branch.oid ")))
+            {
+               const auto sha = record.mid(13);
+               wipInfo.parentSha = sha == QLatin1String("(initial)") ? CommitInfo::INIT_SHA : sha;
+            }
+            break;
+         case '1':
+            if (const auto path = skipFields(record, 8); path != -1)
+               addFile(wipInfo.files, record.mid(path), fileStatus(record.at(2), record.at(3)));
+            break;
+         case '2':
+         {
+            // The original path of a rename or a copy is the next record.
+            end = status.indexOf(QChar::Null, start);
+
+            if (end == -1)
+               end = length;
+
+            const auto origPath = status.mid(start, end - start);
+
+            start = end + 1;
+
+            if (const auto path = skipFields(record, 9); path != -1)
+            {
+               addFile(wipInfo.files, record.mid(path), fileStatus(record.at(2), record.at(3)));
+
+               if (record.at(2) == QLatin1Char('R'))
+                  addFile(wipInfo.files, origPath, RevisionFiles::DELETED | RevisionFiles::IN_INDEX);
+            }
+            break;
+         }
+         case 'u':
+            if (const auto path = skipFields(record, 10); path != -1)
+               addFile(wipInfo.files, record.mid(path), RevisionFiles::MODIFIED | RevisionFiles::CONFLICT);
+            break;
+         case '?':
+         {
+            const auto path = record.mid(2);
+
+            wipInfo.untrackedFiles.append(path);
+            addFile(wipInfo.files, path, RevisionFiles::UNKNOWN);
+            break;
+         }
+         default:
+            break;
+      }
+   }
 
-   return false;
+   return wipInfo;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QSharedPointer>
+#include <QStringList>
 
 #include <WipRevisionInfo.h>
 
@@ -12,11 +13,28 @@ class GitWip
 public:
    explicit GitWip(const QSharedPointer<GitBase> &git, const QSharedPointer<GitCache> &cache);
 
-   QVector<QString> getUntrackedFiles() const;
-   bool updateWip() const;
+   /**
+    * @brief updateWip Updates the WIP in the cache.
+    *
+    * @param directories The directories of the working tree that changed, relative to it. Only those are listed
+    * again and the rest of the WIP is kept. If it's empty, or HEAD changed, the whole WIP is listed.
+    * @return True if the cache was updated.
+    */
+   bool updateWip(const QStringList &directories = QStringList()) const;
    WipRevisionInfo getWipInfo() const;
 
+   /**
+    * @brief parseStatus Parses the output of git status --porcelain=v2 -z --branch in one pass. The staged and the
+    * unstaged changes of every file are merged in the same entry.
+    *
+    * @param status The output of git status.
+    * @return The WIP information. It's not valid if the output doesn't have the branch headers.
+    */
+   static WipRevisionInfo parseStatus(const QString &status);
+
 private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitCache> mCache;
+
+   QString statusCommand(const QStringList &directories = QStringList()) const;
 };
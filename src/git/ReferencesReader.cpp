@@ -0,0 +1,267 @@
+#include "ReferencesReader.h"
+
+#include <GitBase.h>
+
+#include <QLogger.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace QLogger;
+
+namespace
+{
+// Levels of symbolic references followed before giving up, the same limit Git uses.
+const int MAX_SYMREF_DEPTH = 5;
+
+bool isPerWorktree(const QByteArray &name)
+{
+   return name.startsWith("refs/bisect/") || name.startsWith("refs/worktree/") || name.startsWith("refs/rewritten/");
+}
+
+ObjectId parseSha(const QByteArray &line)
+{
+   return line.size() >= ObjectId::HEX_SIZE ? ObjectId::fromHex(line.constData(), ObjectId::HEX_SIZE) : ObjectId();
+}
+}
+
+ReferencesReader::ReferencesReader(const QSharedPointer<GitBase> &git)
+   : mGit(git)
+{
+}
+
+std::optional<QVector<ReferencesReader::Reference>> ReferencesReader::read()
+{
+   const auto gitDir = mGit->getGitDir();
+   const auto commonDir = mGit->getCommonDir();
+
+   if (QFileInfo::exists(QString("%1/reftable").arg(commonDir)))
+      return std::nullopt;
+
+   readPackedRefs(QString("%1/packed-refs").arg(commonDir));
+
+   // The loose references override the packed ones. The files that are gone are dropped from the cache.
+   auto refs = mPackedRefs;
+   QHash<QString, CachedFile> files;
+
+   if (gitDir == commonDir)
+      readLooseRefs(gitDir, Scope::All, refs, files);
+   else
+   {
+      readLooseRefs(commonDir, Scope::Shared, refs, files);
+      readLooseRefs(gitDir, Scope::PerWorktree, refs, files);
+   }
+
+   mLooseFiles = std::move(files);
+
+   for (auto iter = refs.begin(); iter != refs.end();)
+   {
+      if (!iter->target.isEmpty())
+      {
+         auto target = refs.constFind(iter->target);
+
+         for (auto depth = 1; depth < MAX_SYMREF_DEPTH && target != refs.cend() && !target->target.isEmpty(); ++depth)
+            target = refs.constFind(target->target);
+
+         if (target == refs.cend() || !target->sha.isValid())
+         {
+            iter = refs.erase(iter);
+            continue;
+         }
+
+         iter->sha = target->sha;
+         iter->peeled = target->peeled;
+         iter->needsPeeling = target->needsPeeling;
+      }
+
+      ++iter;
+   }
+
+   if (!peelTags(refs))
+      return std::nullopt;
+
+   QVector<Reference> references;
+   references.reserve(refs.count());
+
+   for (auto iter = refs.cbegin(); iter != refs.cend(); ++iter)
+   {
+      references.append({ iter.key(), iter->sha, iter->modified });
+
+      if (iter->peeled.isValid() && iter->peeled != iter->sha)
+         references.append({ iter.key() + "^{}", iter->peeled, iter->modified });
+   }
+
+   return references;
+}
+
+QVector<ReferencesReader::Reference> ReferencesReader::parseShowRef(const QByteArray &output)
+{
+   QVector<Reference> references;
+   const auto lines = output.split('\n');
+
+   for (const auto &line : lines)
+   {
+      if (const auto sha = parseSha(line); sha.isValid() && line.size() > ObjectId::HEX_SIZE + 1)
+         references.append({ line.mid(ObjectId::HEX_SIZE + 1), sha, 0 });
+   }
+
+   return references;
+}
+
+void ReferencesReader::readPackedRefs(const QString &path)
+{
+   const QFileInfo info(path);
+   const auto modified = info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+   const auto size = info.exists() ? info.size() : -1;
+
+   if (modified == mPackedFile.modified && size == mPackedFile.size)
+      return;
+
+   mPackedFile = { modified, size, QByteArray() };
+   mPackedRefs.clear();
+
+   QFile file(path);
+
+   if (!file.open(QIODevice::ReadOnly))
+      return;
+
+   const auto content = file.readAll();
+   const auto lines = content.split('\n');
+
+   // Without the traits in the header, it's unknown if the tags without a peeled line are annotated or not.
+   auto peeledTags = false;
+   auto last = mPackedRefs.end();
+
+   for (const auto &line : lines)
+   {
+      if (line.startsWith("# pack-refs with:"))
+      {
+         const auto traits = line.mid(17).split(' ');
+         peeledTags = traits.contains("fully-peeled") || traits.contains("peeled");
+      }
+      else if (line.startsWith('^'))
+      {
+         if (last != mPackedRefs.end())
+         {
+            last->peeled = parseSha(line.mid(1));
+            last->needsPeeling = false;
+         }
+      }
+      else if (const auto sha = parseSha(line); sha.isValid() && line.size() > ObjectId::HEX_SIZE + 1)
+      {
+         const auto name = line.mid(ObjectId::HEX_SIZE + 1);
+         Entry entry;
+         entry.sha = sha;
+         entry.modified = modified;
+         entry.needsPeeling = !peeledTags && name.startsWith("refs/tags/");
+
+         last = mPackedRefs.insert(name, entry);
+      }
+   }
+}
+
+void ReferencesReader::readLooseRefs(const QString &gitDir, Scope scope, QMap<QByteArray, Entry> &refs,
+                                     QHash<QString, CachedFile> &files) const
+{
+   const auto refsDir = QString("%1/refs").arg(gitDir);
+   const auto prefixLength = gitDir.length() + 1;
+
+   QDirIterator iterator(refsDir, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+
+   while (iterator.hasNext())
+   {
+      const auto path = iterator.next();
+      const auto name = path.mid(prefixLength).toUtf8();
+
+      if (name.endsWith(".lock") || (scope != Scope::All && isPerWorktree(name) != (scope == Scope::PerWorktree)))
+         continue;
+
+      const auto info = iterator.fileInfo();
+      auto file = mLooseFiles.value(path);
+
+      if (const auto modified = info.lastModified().toMSecsSinceEpoch();
+          file.modified != modified || file.size != info.size())
+      {
+         QFile loose(path);
+
+         if (!loose.open(QIODevice::ReadOnly))
+            continue;
+
+         file = { modified, info.size(), loose.readAll().trimmed() };
+      }
+
+      files.insert(path, file);
+
+      Entry entry;
+      entry.modified = file.modified;
+
+      if (file.content.startsWith("ref: "))
+         entry.target = file.content.mid(5).trimmed();
+      else
+      {
+         entry.sha = parseSha(file.content);
+
+         if (!entry.sha.isValid())
+            continue;
+
+         // A loose tag could be annotated: only git knows it without reading the object.
+         entry.needsPeeling = name.startsWith("refs/tags/");
+      }
+
+      refs.insert(name, entry);
+   }
+}
+
+bool ReferencesReader::peelTags(QMap<QByteArray, Entry> &refs)
+{
+   auto pending = false;
+
+   for (auto iter = refs.begin(); iter != refs.end(); ++iter)
+   {
+      if (iter->needsPeeling)
+      {
+         if (const auto peeled = mPeeled.constFind(iter->sha); peeled != mPeeled.cend())
+         {
+            iter->peeled = *peeled;
+            iter->needsPeeling = false;
+         }
+         else
+            pending = true;
+      }
+   }
+
+   if (!pending)
+      return true;
+
+   QLog_Debug("Git", "Peeling the tags that are not packed.");
+
+   const auto ret = mGit->run("git for-each-ref --format=%(objectname)%(*objectname) refs/tags");
+
+   if (!ret.success)
+      return false;
+
+   const auto lines = ret.output.toUtf8().split('\n');
+
+   for (const auto &line : lines)
+   {
+      if (const auto sha = parseSha(line); sha.isValid())
+      {
+         const auto peeled = parseSha(line.mid(ObjectId::HEX_SIZE));
+         mPeeled.insert(sha, peeled.isValid() ? peeled : sha);
+      }
+   }
+
+   for (auto iter = refs.begin(); iter != refs.end(); ++iter)
+   {
+      if (iter->needsPeeling)
+      {
+         iter->peeled = mPeeled.value(iter->sha);
+         iter->needsPeeling = false;
+      }
+   }
+
+   return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <ObjectId.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <optional>
+
+class GitBase;
+
+/**
+ * @brief The ReferencesReader class reads the references of a repository from its files instead of running
+ * git show-ref. It parses the packed-refs file and walks the loose references, following the layout of the linked
+ * worktrees: the per-worktree references are read from the worktree and the rest from the common directory.
+ *
+ * The reader keeps the content of every file together with its modification time, so the next reads only open the
+ * files that changed. The annotated tags that are not peeled in packed-refs are peeled with git once, since a tag
+ * object never changes.
+ */
+class ReferencesReader
+{
+public:
+   struct Reference
+   {
+      QByteArray name;
+      ObjectId sha;
+      // Modification time of the file the reference was read from, in milliseconds since epoch.
+      qint64 modified = 0;
+   };
+
+   explicit ReferencesReader(const QSharedPointer<GitBase> &git);
+
+   /**
+    * @brief read Reads all the references the same way git show-ref -d lists them: every annotated tag is followed
+    * by another entry with the suffix ^{} and the SHA of the commit it points to.
+    *
+    * @return The references sorted by name or nothing if the references can't be read natively (i.e. reftable).
+    */
+   std::optional<QVector<Reference>> read();
+
+   /**
+    * @brief parseShowRef Parses the output of git show-ref -d into the same list read() returns.
+    */
+   static QVector<Reference> parseShowRef(const QByteArray &output);
+
+private:
+   enum class Scope
+   {
+      All,
+      Shared,
+      PerWorktree,
+   };
+
+   struct Entry
+   {
+      ObjectId sha;
+      ObjectId peeled;
+      QByteArray target;
+      qint64 modified = 0;
+      bool needsPeeling = false;
+   };
+
+   struct CachedFile
+   {
+      qint64 modified = -1;
+      qint64 size = -1;
+      QByteArray content;
+   };
+
+   QSharedPointer<GitBase> mGit;
+   CachedFile mPackedFile;
+   QMap<QByteArray, Entry> mPackedRefs;
+   QHash<QString, CachedFile> mLooseFiles;
+   QHash<ObjectId, ObjectId> mPeeled;
+
+   void readPackedRefs(const QString &path);
+   void readLooseRefs(const QString &gitDir, Scope scope, QMap<QByteArray, Entry> &refs,
+                      QHash<QString, CachedFile> &files) const;
+   bool peelTags(QMap<QByteArray, Entry> &refs);
+};
@@ -1,5 +1,6 @@
 #include "GitHubRestApi.h"
 #include <Issue.h>
+#include <Tracer.h>
 
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
@@ -455,6 +456,9 @@ QNetworkRequest GitHubRestApi::createRequest(const QString &page) const
    request.setRawHeader("Accept", "application/vnd.github.v3+json");
    request.setRawHeader("Authorization", mAuthString);
 
+   if (Tracer::getInstance()->isEnabled())
+      request.setAttribute(QNetworkRequest::User, Tracer::getInstance()->now());
+
    return request;
 }
 
@@ -1,6 +1,7 @@
 #include "GitLabRestApi.h"
 #include <GitQlientSettings.h>
 #include <Issue.h>
+#include <Tracer.h>
 
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -201,6 +202,9 @@ QNetworkRequest GitLabRestApi::createRequest(const QString &page) const
    request.setRawHeader(QByteArray("PRIVATE-TOKEN"),
                         QByteArray(QString(QStringLiteral("%1")).arg(mAuth.userPass).toLocal8Bit()));
 
+   if (Tracer::getInstance()->isEnabled())
+      request.setAttribute(QNetworkRequest::User, Tracer::getInstance()->now());
+
    return request;
 }
 
@@ -1,5 +1,7 @@
 #include <IRestApi.h>
 
+#include <Tracer.h>
+
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QJsonDocument>
@@ -16,6 +18,12 @@ IRestApi::IRestApi(const ServerAuthentication &auth, QObject *parent)
    , mManager(new QNetworkAccessManager())
    , mAuth(auth)
 {
+   connect(mManager, &QNetworkAccessManager::finished, this, [](QNetworkReply *reply) {
+      const auto start = reply->request().attribute(QNetworkRequest::User);
+
+      if (start.isValid())
+         Tracer::getInstance()->addSpan("Network", "REST request", start.toLongLong(), reply->url().toString());
+   });
 }
 
 IRestApi::~IRestApi()
@@ -5,6 +5,7 @@
 #include <GitBase.h>
 #include <GitCache.h>
 #include <GitServerCache.h>
+#include <Tracer.h>
 
 #include <QDateTime>
 #include <QLocale>
@@ -22,11 +23,17 @@ CommitHistoryModel::CommitHistoryModel(const QSharedPointer<GitCache> &cache, co
    mColumns.insert(CommitHistoryColumns::Log, "History");
    mColumns.insert(CommitHistoryColumns::Author, "Author");
    mColumns.insert(CommitHistoryColumns::Date, "Date");
+
+   connect(mCache.data(), &GitCache::signalCommitTextsLoaded, this, [this]() {
+      if (mRowCount > 0)
+         emit dataChanged(index(0, static_cast<int>(CommitHistoryColumns::Log)),
+                          index(mRowCount - 1, static_cast<int>(CommitHistoryColumns::Author)));
+   });
 }
 
 int CommitHistoryModel::rowCount(const QModelIndex &parent) const
 {
-   return !parent.isValid() ? mCache->commitCount() : 0;
+   return !parent.isValid() ? mRowCount : 0;
 }
 
 bool CommitHistoryModel::hasChildren(const QModelIndex &parent) const
@@ -42,6 +49,7 @@ QString CommitHistoryModel::sha(int row) const
 void CommitHistoryModel::clear()
 {
    beginResetModel();
+   mRowCount = 0;
    endResetModel();
    emit headerDataChanged(Qt::Horizontal, 0, 5);
 }
@@ -49,10 +57,37 @@ void CommitHistoryModel::clear()
 void CommitHistoryModel::onNewRevisions(int totalCommits)
 {
    beginResetModel();
+   mRowCount = totalCommits;
    endResetModel();
+}
+
+void CommitHistoryModel::onRevisionsAppended(int totalCommits)
+{
+   if (totalCommits > mRowCount)
+   {
+      beginInsertRows(QModelIndex(), mRowCount, totalCommits - 1);
+      mRowCount = totalCommits;
+      endInsertRows();
+   }
+}
+
+void CommitHistoryModel::onRevisionsInserted(const QVector<int> &rows)
+{
+   for (auto i = 0; i < rows.count();)
+   {
+      const auto first = rows.at(i);
+      auto last = first;
+
+      while (++i < rows.count() && rows.at(i) == last + 1)
+         ++last;
+
+      beginInsertRows(QModelIndex(), first, last);
+      mRowCount += last - first + 1;
+      endInsertRows();
+   }
 
-   beginInsertRows(QModelIndex(), 0, totalCommits - 2);
-   endInsertRows();
+   if (mRowCount > 0)
+      emit dataChanged(index(0, 0), index(mRowCount - 1, columnCount() - 1));
 }
 
 QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -65,7 +100,7 @@ QVariant CommitHistoryModel::headerData(int section, Qt::Orientation orientation
 
 QModelIndex CommitHistoryModel::index(int row, int column, const QModelIndex &) const
 {
-   return row >= 0 && row < mCache->commitCount() ? createIndex(row, column, nullptr) : QModelIndex();
+   return row >= 0 && row < mRowCount ? createIndex(row, column, nullptr) : QModelIndex();
 }
 
 QModelIndex CommitHistoryModel::parent(const QModelIndex &) const
@@ -104,7 +139,7 @@ QVariant CommitHistoryModel::getToolTipData(const CommitInfo &r) const
    auto tooltip = sha == CommitInfo::ZERO_SHA
        ? QString()
        : QString("<p>%1 - %2</p><p>%3</p>%4%5")
-             .arg(r.author.split("<").first(), d.toString(locale.dateTimeFormat(QLocale::ShortFormat)), sha,
+             .arg(r.author.name, d.toString(locale.dateTimeFormat(QLocale::ShortFormat)), sha,
                   !auxMessage.isEmpty() ? QString("<p>%1</p>").arg(auxMessage) : "",
                   r.isSigned()
                       ? tr("<p> GPG key (%1): %2</p>")
@@ -130,10 +165,8 @@ QVariant CommitHistoryModel::getDisplayData(const CommitInfo &rev, int column) c
       }
       case CommitHistoryColumns::Log:
          return rev.shortLog;
-      case CommitHistoryColumns::Author: {
-         const auto author = rev.author.split("<").first();
-         return author;
-      }
+      case CommitHistoryColumns::Author:
+         return rev.author.name;
       case CommitHistoryColumns::Date: {
          return QDateTime::fromSecsSinceEpoch(rev.dateSinceEpoch.count()).toString("dd MMM yyyy hh:mm");
       }
@@ -147,10 +180,18 @@ QVariant CommitHistoryModel::data(const QModelIndex &index, int role) const
    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole))
       return QVariant();
 
+   TRACE_SPAN("UI", "History data");
+
+   // The history can be loaded without the texts, they are only requested for the rows that are shown. A placeholder
+   // is shown until the loader inserts them in the cache.
+   const auto hasText = mCache->requestCommitText(index.row());
    const auto r = mCache->commitInfo(index.row());
 
    if (role == Qt::ToolTipRole)
-      return getToolTipData(r);
+      return hasText ? getToolTipData(r) : QVariant();
+
+   if (!hasText && index.column() == static_cast<int>(CommitHistoryColumns::Log))
+      return tr("Loading...");
 
    if (role == Qt::DisplayRole)
       return getDisplayData(r, index.column());
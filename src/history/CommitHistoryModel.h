@@ -125,6 +125,19 @@ public:
     * @param totalCommits The total of new revisions.
     */
    void onNewRevisions(int totalCommits);
+   /**
+    * @brief Notifies the views about the rows added at the end of the cache since the last update.
+    *
+    * @param totalCommits The new total of revisions.
+    */
+   void onRevisionsAppended(int totalCommits);
+   /**
+    * @brief Notifies the views about the rows inserted in the middle of the history by an incremental reload. The
+    * graph of the rows below them can change, so they are repainted.
+    *
+    * @param rows The final positions of the new rows, in ascending order.
+    */
+   void onRevisionsInserted(const QVector<int> &rows);
    /*!
     * \brief Gets the number of columns in the model.
     * \return The number of columns.
@@ -136,6 +149,7 @@ private:
    QSharedPointer<GitBase> mGit;
    QSharedPointer<GitServerCache> mGitServerCache;
    QMap<CommitHistoryColumns, QString> mColumns;
+   int mRowCount = 0;
 
    /**
     * @brief Returns the tool tip data.
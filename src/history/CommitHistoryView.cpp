@@ -12,10 +12,14 @@
 
 #include <QDateTime>
 #include <QHeaderView>
+#include <QScrollBar>
 
 #include <QLogger.h>
 using namespace QLogger;
 
+// Rows before the end of the view where the next page of the history is requested.
+static const int NEXT_PAGE_MARGIN_ROWS = 100;
+
 CommitHistoryView::CommitHistoryView(const QSharedPointer<GitCache> &cache, const QSharedPointer<GitBase> &git,
                                      const QSharedPointer<GitQlientSettings> &settings,
                                      const QSharedPointer<GitServerCache> &gitServerCache, QWidget *parent)
@@ -38,6 +42,11 @@ CommitHistoryView::CommitHistoryView(const QSharedPointer<GitCache> &cache, cons
 
    connect(mCache.get(), &GitCache::signalCacheUpdated, this, &CommitHistoryView::refreshView);
 
+   connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+      if (value >= verticalScrollBar()->maximum() - NEXT_PAGE_MARGIN_ROWS)
+         emit signalNextPageRequested();
+   });
+
    connect(this, &CommitHistoryView::doubleClicked, this, [this](const QModelIndex &index) {
       if (mCommitHistoryModel)
       {
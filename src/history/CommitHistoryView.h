@@ -97,6 +97,10 @@ signals:
     * @param pr The pull request number to show.
     */
    void showPrDetailedView(int pr);
+   /**
+    * @brief signalNextPageRequested Signal triggered when the user scrolls close to the last loaded revision.
+    */
+   void signalNextPageRequested();
 
 public:
    /**
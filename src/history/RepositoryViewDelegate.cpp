@@ -13,6 +13,7 @@
 #include <Lane.h>
 #include <LaneType.h>
 #include <PullRequest.h>
+#include <Tracer.h>
 
 #include <QApplication>
 #include <QClipboard>
@@ -37,10 +38,13 @@ RepositoryViewDelegate::RepositoryViewDelegate(const QSharedPointer<GitCache> &c
    , mGitServerCache(gitServerCache)
    , mView(view)
 {
+   connect(mCache.data(), &GitCache::signalLanesComputed, this, [this]() { mView->viewport()->update(); });
 }
 
 void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt, const QModelIndex &index) const
 {
+   TRACE_SPAN("UI", "Paint history row");
+
    p->setRenderHints(QPainter::Antialiasing);
 
    QStyleOptionViewItem newOpt(opt);
@@ -55,13 +59,20 @@ void RepositoryViewDelegate::paint(QPainter *p, const QStyleOptionViewItem &opt,
        ? dynamic_cast<QSortFilterProxyModel *>(mView->model())->mapToSource(index).row()
        : index.row();
 
+   // The rows far from the ones with lanes are painted without graph until the loader thread reaches them.
+   const auto isGraph = index.column() == static_cast<int>(CommitHistoryColumns::Graph);
+   const auto hasLanes = isGraph && mCache->computeLanes(row);
+
    const auto commit = mCache->commitInfo(row);
 
    if (commit.sha.isEmpty())
       return;
 
-   if (index.column() == static_cast<int>(CommitHistoryColumns::Graph))
+   if (isGraph)
    {
+      if (!hasLanes)
+         return;
+
       newOpt.rect.setX(newOpt.rect.x() + 10);
       paintGraph(p, newOpt, commit);
    }
@@ -460,14 +471,15 @@ void RepositoryViewDelegate::paintTagBranch(QPainter *painter, QStyleOptionViewI
    {
       QVector<QString> marks;
       QVector<QColor> colors;
-      const auto currentBranch = mGit->getCurrentBranch();
+      const auto repoState = mGit->getRepoState();
+      const auto &currentBranch = repoState->currentBranch;
 
       if (startPoint == 0)
          startPoint = 5;
 
-      if ((currentBranch.isEmpty() || currentBranch == "HEAD"))
+      if (repoState->isDetached())
       {
-         if (const auto ret = mGit->getLastCommit(); ret.success && sha == ret.output.trimmed())
+         if (!repoState->head.isEmpty() && sha == repoState->head)
          {
             marks.append("detached");
             colors.append(graphDetached);
@@ -5,6 +5,7 @@
 
 #include <GitQlient.h>
 #include <QLogger.h>
+#include <Tracer.h>
 
 using namespace QLogger;
 
@@ -32,7 +33,11 @@ int main(int argc, char *argv[])
 
       QTimer::singleShot(500, &mainWin, &GitQlient::restorePinnedRepos);
 
-      return app.exec();
+      const auto ret = app.exec();
+
+      Tracer::getInstance()->stop();
+
+      return ret;
    }
 
    return 0;
@@ -0,0 +1,121 @@
+#include "Tracer.h"
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+
+#include <QLogger.h>
+
+using namespace QLogger;
+
+Tracer *Tracer::getInstance()
+{
+   static Tracer tracer;
+
+   return &tracer;
+}
+
+void Tracer::start(const QString &fileName)
+{
+   QMutexLocker lock(&mMutex);
+
+   if (isEnabled())
+      return;
+
+   mFileName = fileName;
+   mEvents.clear();
+   mNextEvent = 0;
+   mDroppedEvents = 0;
+   mTimer.start();
+   mEnabled.store(true, std::memory_order_release);
+
+   QLog_Info("UI", QString("Tracing into {%1}.").arg(fileName));
+}
+
+bool Tracer::stop()
+{
+   QMutexLocker lock(&mMutex);
+
+   if (!isEnabled())
+      return false;
+
+   mEnabled.store(false, std::memory_order_release);
+
+   if (mDroppedEvents > 0)
+      QLog_Warning("UI", QString("The trace only has the last {%1} spans, {%2} were dropped.")
+                             .arg(MAX_EVENTS)
+                             .arg(mDroppedEvents));
+
+   // Chrome expects small thread ids.
+   const auto pid = QCoreApplication::applicationPid();
+   QHash<quintptr, int> threads;
+   QJsonArray events;
+
+   for (auto i = 0; i < mEvents.count(); ++i)
+   {
+      const auto &event = mEvents.at((mNextEvent + i) % mEvents.count());
+      auto thread = threads.value(event.thread, -1);
+
+      if (thread == -1)
+      {
+         thread = threads.count() + 1;
+         threads.insert(event.thread, thread);
+      }
+
+      QJsonObject json { { "name", QString::fromLatin1(event.name) },
+                         { "cat", QString::fromLatin1(event.category) },
+                         { "ph", "X" },
+                         { "ts", event.start },
+                         { "dur", event.duration },
+                         { "pid", pid },
+                         { "tid", thread } };
+
+      if (!event.args.isEmpty())
+         json.insert("args", QJsonObject { { "details", event.args } });
+
+      events.append(json);
+   }
+
+   mEvents.clear();
+   mEvents.squeeze();
+   mNextEvent = 0;
+
+   QSaveFile file(mFileName);
+
+   if (!file.open(QIODevice::WriteOnly))
+      return false;
+
+   file.write(QJsonDocument(QJsonObject { { "traceEvents", events }, { "displayTimeUnit", "ms" } }).toJson(
+       QJsonDocument::Compact));
+
+   const auto written = file.commit();
+
+   if (!written)
+      QLog_Warning("UI", QString("The trace couldn't be written into {%1}.").arg(mFileName));
+
+   return written;
+}
+
+void Tracer::addSpan(const char *category, const char *name, qint64 start, const QString &args)
+{
+   const auto duration = now() - start;
+   const auto thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+   QMutexLocker lock(&mMutex);
+
+   if (!isEnabled())
+      return;
+
+   if (mEvents.count() < MAX_EVENTS)
+      mEvents.append({ category, name, start, duration, thread, args });
+   else
+   {
+      mEvents[mNextEvent] = { category, name, start, duration, thread, args };
+      mNextEvent = (mNextEvent + 1) % MAX_EVENTS;
+      ++mDroppedEvents;
+   }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+/****************************************************************************************
+ ** GitQlient is an application to manage and operate one or several Git repositories. With
+ ** GitQlient you will be able to add commits, branches and manage all the options Git provides.
+ ** Copyright (C) 2021  Francesc Martinez
+ **
+ ** LinkedIn: www.linkedin.com/in/cescmm/
+ ** Web: www.francescmm.com
+ **
+ ** This program is free software; you can redistribute it and/or
+ ** modify it under the terms of the GNU Lesser General Public
+ ** License as published by the Free Software Foundation; either
+ ** version 2 of the License, or (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ ** Lesser General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public
+ ** License along with this library; if not, write to the Free Software
+ ** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ ***************************************************************************************/
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+/**
+ * @brief The Tracer class records spans of time in the Chrome trace-event format, so the trace can be opened in
+ * chrome://tracing or in Perfetto. It is enabled from the command line (--trace <file>) or with the "traceFile"
+ * setting, and the file is written when the application exits.
+ *
+ * When it's disabled, a span only costs the check of an atomic flag. Only the last MAX_EVENTS spans are kept, so a long
+ * session doesn't grow without limit.
+ */
+class Tracer
+{
+public:
+   static Tracer *getInstance();
+
+   /**
+    * @brief start Enables the tracing.
+    * @param fileName The file where the trace is written when it stops.
+    */
+   void start(const QString &fileName);
+
+   /**
+    * @brief stop Disables the tracing and writes the trace file.
+    * @return True if the file was written.
+    */
+   bool stop();
+
+   // The acquire pairs with the release in start(), so a thread that sees the tracing enabled sees the timer started.
+   bool isEnabled() const { return mEnabled.load(std::memory_order_acquire); }
+
+   /**
+    * @brief now Returns the time since the tracing started, in microseconds. It's only valid when isEnabled() is true.
+    */
+   qint64 now() const { return mTimer.nsecsElapsed() / 1000; }
+
+   /**
+    * @brief addSpan Records a span that started at @p start and finishes now.
+    *
+    * @param category The category of the span. It must be a string literal.
+    * @param name The name of the span. It must be a string literal.
+    * @param start The start as returned by now().
+    * @param args Optional details of the span, like the command that was run.
+    */
+   void addSpan(const char *category, const char *name, qint64 start, const QString &args = QString());
+
+private:
+   struct Event
+   {
+      const char *category;
+      const char *name;
+      qint64 start;
+      qint64 duration;
+      quintptr thread;
+      QString args;
+   };
+
+   static constexpr int MAX_EVENTS = 512 * 1024;
+
+   std::atomic<bool> mEnabled { false };
+   QElapsedTimer mTimer;
+   QString mFileName;
+   QMutex mMutex;
+   // Ring buffer: once it's full, mNextEvent is the oldest event and it's the next one overwritten.
+   QVector<Event> mEvents;
+   int mNextEvent = 0;
+   qint64 mDroppedEvents = 0;
+
+   Tracer() = default;
+};
+
+/**
+ * @brief The TraceSpan class records a span for the lifetime of the object.
+ */
+class TraceSpan
+{
+public:
+   TraceSpan(const char *category, const char *name)
+      : mCategory(category)
+      , mName(name)
+      , mStart(Tracer::getInstance()->isEnabled() ? Tracer::getInstance()->now() : -1)
+   {
+   }
+
+   ~TraceSpan()
+   {
+      if (mStart >= 0)
+         Tracer::getInstance()->addSpan(mCategory, mName, mStart, mArgs);
+   }
+
+   TraceSpan(const TraceSpan &) = delete;
+   TraceSpan &operator=(const TraceSpan &) = delete;
+
+   /**
+    * @brief setArgs Sets the details of the span. It's ignored when the tracing is disabled.
+    */
+   void setArgs(const QString &args)
+   {
+      if (mStart >= 0)
+         mArgs = args;
+   }
+
+private:
+   const char *mCategory;
+   const char *mName;
+   qint64 mStart;
+   QString mArgs;
+};
+
+#define TRACE_SPAN_CONCAT_IMPL(name, line) name##line
+#define TRACE_SPAN_CONCAT(name, line) TRACE_SPAN_CONCAT_IMPL(name, line)
+#define TRACE_SPAN(category, name) const TraceSpan TRACE_SPAN_CONCAT(traceSpan, __LINE__)(category, name)
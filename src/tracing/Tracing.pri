@@ -0,0 +1,7 @@
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/Tracer.h
+
+SOURCES += \
+    $$PWD/Tracer.cpp